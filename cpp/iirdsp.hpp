@@ -49,6 +49,20 @@ public:
         iirdsp_process_buffer(&filter_, x, y, N);
     }
 
+    /**
+     * Process a buffer of int16 ADC samples (conversion fused into the loop)
+     */
+    void process_buffer(const int16_t* x, iirdsp_real scale, iirdsp_real* y, int N) {
+        iirdsp_process_buffer_i16(&filter_, x, scale, y, N);
+    }
+
+    /**
+     * Process int16 samples in, saturated int16 samples out
+     */
+    void process_buffer(const int16_t* x, int16_t* y, iirdsp_real in_scale, iirdsp_real out_scale, int N) {
+        iirdsp_process_buffer_i16_i16(&filter_, x, y, in_scale, out_scale, N);
+    }
+
     /**
      * Process a std::vector
      */
@@ -81,6 +95,15 @@ public:
         iirdsp_filter_reset(&filter_);
     }
 
+    /**
+     * Set state to the steady state for a constant input level
+     */
+    void init_steady(iirdsp_real x0) {
+        if (iirdsp_filter_init_steady(&filter_, x0) != 0) {
+            throw std::runtime_error("Filter has no steady state (pole at DC)");
+        }
+    }
+
     /**
      * Access underlying C structure
      */
@@ -149,6 +172,26 @@ public:
     }
 };
 
+/**
+ * Butterworth band-stop filter
+ */
+class ButterBandStop : public Filter {
+public:
+    /**
+     * Initialize band-stop filter
+     *
+     * @param order Filter order
+     * @param f_low_hz Low cutoff frequency (Hz)
+     * @param f_high_hz High cutoff frequency (Hz)
+     * @param fs_hz Sampling frequency (Hz)
+     */
+    ButterBandStop(int order, iirdsp_real f_low_hz, iirdsp_real f_high_hz, iirdsp_real fs_hz) {
+        if (butter_bandstop_init(&filter_, order, f_low_hz, f_high_hz, fs_hz) != 0) {
+            throw std::runtime_error("Failed to initialize band-stop filter");
+        }
+    }
+};
+
 /**
  * Digital notch filter
  */
@@ -0,0 +1,127 @@
+/**
+ * @file bench_precision.c
+ * @brief Cost and accuracy of the float cascades vs. running in double
+ *
+ * Runs the 500 Hz ECG front end (0.5 Hz high-pass, 40 Hz order-4
+ * low-pass, 50 Hz Q=30 notch) over a float buffer and reports nanoseconds
+ * per sample and relative RMS error against the double design for:
+ *   - every section float DF2T
+ *   - error feedback on the near-unit-circle sections (errfb.h)
+ *   - error feedback on every section
+ *   - coupled form on the near-unit-circle sections (coupled.h)
+ *   - double on the near-unit-circle sections (mixed.h)
+ *   - every section double, float I/O only
+ *
+ * Build in Release mode. On targets whose FPU is single precision only
+ * (Cortex-M4F) double runs in software and the last two rows grow by an
+ * order of magnitude; on desktop FPUs double costs the same as float.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "iirdsp.h"
+
+#define FS 500.0
+#define FRAMES 4096
+#define REPEATS 200
+#define ERROR_SAMPLES 20000
+
+typedef void (*process_fn)(void* c, const float* x, float* y, int N);
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void errfb_buffer(void* c, const float* x, float* y, int N)
+{
+    iirdsp_errfb_process_buffer((iirdsp_errfb_t*)c, x, y, N);
+}
+
+static void coupled_buffer(void* c, const float* x, float* y, int N)
+{
+    iirdsp_coupled_process_buffer((iirdsp_coupled_t*)c, x, y, N);
+}
+
+static void mixed_buffer(void* c, const float* x, float* y, int N)
+{
+    iirdsp_mixed_process_buffer((iirdsp_mixed_t*)c, x, y, N);
+}
+
+/* Best of REPEATS runs over FRAMES samples, in ns per sample */
+static double time_ns(process_fn fn, void* c, const float* x, float* y)
+{
+    double best = HUGE_VAL;
+
+    for (int r = 0; r < REPEATS; r++) {
+        double t0 = now_seconds();
+        fn(c, x, y, FRAMES);
+        best = fmin(best, now_seconds() - t0);
+    }
+    return best / FRAMES * 1e9;
+}
+
+static void report(const char* label, double ns, double err)
+{
+    printf("%-34s %10.2f %12.1f\n", label, ns, 20.0 * log10(err));
+}
+
+int main(void)
+{
+    static iirdsp_errfb_t fb;
+    static iirdsp_coupled_t cf;
+    static iirdsp_biquad_f64_t wide[IIRDSP_MAX_SECTIONS];
+    static iirdsp_biquad_f32_t narrow[IIRDSP_MAX_SECTIONS];
+    static iirdsp_mixed_t m;
+    static float x[FRAMES], y[FRAMES];
+    iirdsp_filter_t hp, lp, notch, chain;
+    double err;
+
+    butter_highpass_init(&hp, 2, 0.5, FS);
+    butter_lowpass_init(&lp, 4, 40.0, FS);
+    notch_filter_init(&notch, 50.0, 30.0, FS);
+    chain = hp;
+    for (int i = 0; i < lp.num_sections; i++) {
+        chain.sections[chain.num_sections++] = lp.sections[i];
+    }
+    chain.sections[chain.num_sections++] = notch.sections[0];
+
+    for (int n = 0; n < FRAMES; n++) {
+        x[n] = (float)(sin(0.015 * n) + 0.2 * sin(0.63 * n));
+    }
+
+    printf("iirdsp precision benchmark (ECG chain, %d sections, %s design)\n",
+           chain.num_sections, sizeof(iirdsp_real) == sizeof(float) ? "float" : "double");
+    printf("%-34s %10s %12s\n", "cascade", "ns/sample", "error (dB)");
+
+    iirdsp_errfb_init(&fb, &chain, 2.0);
+    err = iirdsp_errfb_measure_error(&fb, &chain, ERROR_SAMPLES);
+    report("float DF2T", time_ns(errfb_buffer, &fb, x, y), err);
+
+    iirdsp_errfb_init(&fb, &chain, IIRDSP_ERRFB_DEFAULT_RADIUS);
+    err = iirdsp_errfb_measure_error(&fb, &chain, ERROR_SAMPLES);
+    report("error feedback (radius 0.99)", time_ns(errfb_buffer, &fb, x, y), err);
+
+    iirdsp_errfb_init(&fb, &chain, 0.0);
+    err = iirdsp_errfb_measure_error(&fb, &chain, ERROR_SAMPLES);
+    report("error feedback (all sections)", time_ns(errfb_buffer, &fb, x, y), err);
+
+    iirdsp_coupled_init(&cf, &chain, IIRDSP_COUPLED_DEFAULT_RADIUS);
+    err = iirdsp_coupled_measure_error(&cf, &chain, ERROR_SAMPLES);
+    report("coupled form (radius 0.99)", time_ns(coupled_buffer, &cf, x, y), err);
+
+    iirdsp_mixed_attach(&m, wide, IIRDSP_MAX_SECTIONS, narrow, IIRDSP_MAX_SECTIONS);
+    iirdsp_mixed_init(&m, &chain, IIRDSP_MIXED_DEFAULT_RADIUS);
+    err = iirdsp_mixed_measure_error(&m, &chain, ERROR_SAMPLES);
+    report("mixed precision (radius 0.99)", time_ns(mixed_buffer, &m, x, y), err);
+
+    iirdsp_mixed_init(&m, &chain, 0.0);
+    err = iirdsp_mixed_measure_error(&m, &chain, ERROR_SAMPLES);
+    report("all double, float I/O", time_ns(mixed_buffer, &m, x, y), err);
+
+    return 0;
+}
@@ -15,6 +15,10 @@
 #include <math.h>
 #include "iirdsp.h"
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 /* Signal processing example for ECG data */
 int main(void)
 {
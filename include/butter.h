@@ -13,6 +13,16 @@
 extern "C" {
 #endif
 
+/**
+ * Filter type selector for generic design entry points
+ */
+typedef enum {
+    IIRDSP_LOWPASS = 0,
+    IIRDSP_HIGHPASS = 1,
+    IIRDSP_BANDPASS = 2,
+    IIRDSP_BANDSTOP = 3
+} iirdsp_btype_t;
+
 /**
  * Design a Butterworth low-pass filter
  *
@@ -77,6 +87,165 @@ int butter_bandpass_init(
     iirdsp_real fs_hz
 );
 
+/**
+ * Design a Butterworth band-stop filter
+ *
+ * Rejects [f_low, f_high] (-3 dB at both edges) with unity gain at DC and
+ * Nyquist. Band-stop transformation produces 2*order poles, with zeros on
+ * the unit circle at the geometric (pre-warped) band centre; one design
+ * replaces a row of notches spread over a wide band.
+ * Equivalent to scipy.signal.butter(order, [f_low, f_high], fs=fs_hz, btype='bandstop', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS (band-stop produces 2*order poles).
+ * @param f_low_hz Low cutoff frequency (Hz)
+ * @param f_high_hz High cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int butter_bandstop_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Butterworth low-pass filter into a variable-size cascade
+ *
+ * Same design as butter_lowpass_init, but the sections go into caller
+ * storage, so the order is bounded by c->max_sections and
+ * IIRDSP_DESIGN_MAX_SECTIONS rather than IIRDSP_MAX_SECTIONS.
+ *
+ * @param c Cascade attached to storage (iirdsp_cascade_init)
+ * @param order Filter order; needs (order + 1) / 2 sections
+ * @param cutoff_hz Cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 if the order is invalid or does not fit in c,
+ *         -2 if the cutoff is invalid
+ */
+int butter_lowpass_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Butterworth high-pass filter into a variable-size cascade
+ *
+ * @param c Cascade attached to storage (iirdsp_cascade_init)
+ * @param order Filter order; needs (order + 1) / 2 sections
+ * @param cutoff_hz Cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 if the order is invalid or does not fit in c,
+ *         -2 if the cutoff is invalid
+ */
+int butter_highpass_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Butterworth band-pass filter into a variable-size cascade
+ *
+ * @param c Cascade attached to storage (iirdsp_cascade_init)
+ * @param order Filter order; needs order sections
+ * @param f_low_hz Low cutoff frequency (Hz)
+ * @param f_high_hz High cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 if the order is invalid or does not fit in c,
+ *         -2 if the band edges are invalid
+ */
+int butter_bandpass_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Butterworth band-stop filter into a variable-size cascade
+ *
+ * @param c Cascade attached to storage (iirdsp_cascade_init)
+ * @param order Filter order; needs order sections
+ * @param f_low_hz Low cutoff frequency (Hz)
+ * @param f_high_hz High cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 if the order is invalid or does not fit in c,
+ *         -2 if the band edges are invalid
+ */
+int butter_bandstop_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Minimum Butterworth order for a passband/stopband specification
+ *
+ * Returns the lowest order whose loss is at most gpass_db over the
+ * passband and at least gstop_db over the stopband, and the -3 dB
+ * frequency (or band edges) that puts the passband edge exactly at
+ * gpass_db. For band-pass the order is that of the prototype, as taken by
+ * butter_bandpass_init.
+ * Band-stop specifications are not supported (-3).
+ *
+ * Equivalent to scipy.signal.buttord(wp, ws, gpass, gstop, fs=fs_hz)
+ *
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS or IIRDSP_BANDPASS
+ * @param wp_hz Passband edge (Hz); band-pass: {low, high}
+ * @param ws_hz Stopband edge (Hz); band-pass: {low, high}, outside wp_hz
+ * @param gpass_db Maximum passband loss (dB, > 0)
+ * @param gstop_db Minimum stopband attenuation (dB, > gpass_db)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param wn_hz Output cutoff for the designer (Hz); band-pass: {low, high}.
+ *              May be NULL.
+ * @return Order (>= 1), -2 if the edges are invalid or do not match the
+ *         type, -3 if the type or the gains are invalid
+ */
+int butter_order(
+    iirdsp_btype_t type,
+    const iirdsp_real* wp_hz,
+    const iirdsp_real* ws_hz,
+    iirdsp_real gpass_db,
+    iirdsp_real gstop_db,
+    iirdsp_real fs_hz,
+    iirdsp_real* wn_hz
+);
+
+/**
+ * Design the minimum-order Butterworth filter meeting a specification
+ *
+ * butter_order followed by butter_lowpass_init, butter_highpass_init or
+ * butter_bandpass_init at the returned order and cutoff.
+ *
+ * @param f Filter structure to initialize
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS or IIRDSP_BANDPASS
+ * @param wp_hz Passband edge (Hz); band-pass: {low, high}
+ * @param ws_hz Stopband edge (Hz); band-pass: {low, high}
+ * @param gpass_db Maximum passband loss (dB)
+ * @param gstop_db Minimum stopband attenuation (dB)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 if the order needed does not fit in
+ *         IIRDSP_MAX_SECTIONS, -2 / -3 as butter_order
+ */
+int butter_init_from_spec(
+    iirdsp_filter_t* f,
+    iirdsp_btype_t type,
+    const iirdsp_real* wp_hz,
+    const iirdsp_real* ws_hz,
+    iirdsp_real gpass_db,
+    iirdsp_real gstop_db,
+    iirdsp_real fs_hz
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,160 @@
+/**
+ * @file cheby.h
+ * @brief Chebyshev type I and type II IIR filter design
+ *
+ * For the same transition band, Chebyshev designs need a lower order (so
+ * fewer sections per sample) than Butterworth, at the cost of ripple:
+ * type I ripples in the passband, type II in the stopband. The sections
+ * come from the same bilinear/pairing pipeline as the Butterworth designs.
+ *
+ * Error codes: -1 invalid order (or too many sections), -2 invalid
+ * frequencies, -3 invalid ripple or attenuation.
+ */
+
+#ifndef IIRDSP_CHEBY_H
+#define IIRDSP_CHEBY_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Design a Chebyshev type I low-pass filter
+ *
+ * The passband ripples between 0 and -rp_db dB; cutoff_hz is the end of
+ * the passband, where the response is -rp_db dB (not -3 dB). For even
+ * orders the DC gain is -rp_db dB.
+ * Equivalent to scipy.signal.cheby1(order, rp_db, cutoff_hz, fs=fs_hz, btype='low', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS * 2.
+ * @param rp_db Passband ripple (dB, > 0)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby1_lowpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Chebyshev type I high-pass filter
+ *
+ * Equivalent to scipy.signal.cheby1(order, rp_db, cutoff_hz, fs=fs_hz, btype='high', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS * 2.
+ * @param rp_db Passband ripple (dB, > 0)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby1_highpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Chebyshev type I band-pass filter
+ *
+ * Equivalent to scipy.signal.cheby1(order, rp_db, [f_low, f_high], fs=fs_hz, btype='band', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS (band-pass produces 2*order poles).
+ * @param rp_db Passband ripple (dB, > 0)
+ * @param f_low_hz Low passband edge (Hz)
+ * @param f_high_hz High passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby1_bandpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Chebyshev type II low-pass filter
+ *
+ * The passband is monotonic with unity DC gain; the stopband ripples
+ * between -rs_db dB and full rejection at its zeros. cutoff_hz is the
+ * start of the stopband, where the attenuation first reaches rs_db.
+ * Equivalent to scipy.signal.cheby2(order, rs_db, cutoff_hz, fs=fs_hz, btype='low', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS * 2.
+ * @param rs_db Minimum stopband attenuation (dB, > 0)
+ * @param cutoff_hz Stopband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby2_lowpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Chebyshev type II high-pass filter
+ *
+ * Equivalent to scipy.signal.cheby2(order, rs_db, cutoff_hz, fs=fs_hz, btype='high', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS * 2.
+ * @param rs_db Minimum stopband attenuation (dB, > 0)
+ * @param cutoff_hz Stopband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby2_highpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design a Chebyshev type II band-pass filter
+ *
+ * f_low_hz and f_high_hz are the stopband edges on either side of the
+ * passband.
+ * Equivalent to scipy.signal.cheby2(order, rs_db, [f_low, f_high], fs=fs_hz, btype='band', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS (band-pass produces 2*order poles).
+ * @param rs_db Minimum stopband attenuation (dB, > 0)
+ * @param f_low_hz Low stopband edge (Hz)
+ * @param f_high_hz High stopband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby2_bandpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rs_db,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_CHEBY_H */
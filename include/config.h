@@ -28,4 +28,22 @@ typedef double iirdsp_real;
  */
 #define IIRDSP_MAX_SECTIONS 8
 
+/**
+ * Maximum number of sections the designers can produce into a
+ * variable-size cascade (iirdsp_cascade_t); sizes their stack scratch
+ * Constraint: order <= IIRDSP_DESIGN_MAX_SECTIONS * 2 (band-pass: order <= IIRDSP_DESIGN_MAX_SECTIONS)
+ */
+#define IIRDSP_DESIGN_MAX_SECTIONS 16
+
+/**
+ * Block length (samples) used by the fused integer conversion paths
+ * Sized so the conversion scratch buffer stays in L1 cache.
+ */
+#define IIRDSP_CONVERT_BLOCK 64
+
+/**
+ * Number of frequencies evaluated together by the frequency-response engine
+ */
+#define IIRDSP_FREQZ_BLOCK 64
+
 #endif /* IIRDSP_CONFIG_H */
@@ -0,0 +1,131 @@
+/**
+ * @file coupled.h
+ * @brief Float cascade with the section structure chosen per section
+ *
+ * A Direct Form II Transposed section with poles r e^(+/-j theta) close to
+ * z = 1 is a poor float structure: its coefficients a1 ~ -2, a2 ~ 1 hold
+ * the pole in their last few bits, and its roundoff is amplified by about
+ * 1 / sin(theta). The coupled (Gold-Rader) form recurses on the pole's
+ * real and imaginary parts sigma = r cos(theta), omega = r sin(theta)
+ * instead, which keeps both coefficient and roundoff errors at float
+ * epsilon independent of theta. It costs 7 multiplies per sample against
+ * 5, so only sections near the unit circle use it.
+ *
+ * Independent of IIRDSP_USE_FLOAT: everything runs in float, with the
+ * coupled coefficients derived in double from the designed section.
+ *
+ * The cascade runs one section at a time in scalar float, so it does not
+ * by itself get the twice-as-wide SIMD lanes that float offers over
+ * double; what it removes is the need to run these sections in double.
+ */
+
+#ifndef IIRDSP_COUPLED_H
+#define IIRDSP_COUPLED_H
+
+#include "config.h"
+#include "sos.h"
+#include "mixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default smallest pole radius given the coupled form (same split point
+ * as the mixed cascade)
+ */
+#define IIRDSP_COUPLED_DEFAULT_RADIUS IIRDSP_MIXED_DEFAULT_RADIUS
+
+/**
+ * Coupled-form section in float
+ *
+ * For poles sigma +/- j omega and numerator b0 + b1 z^-1 + b2 z^-2:
+ *   y     = b0 x + g1 s1 + g2 s2
+ *   s1'   = sigma s1 - omega s2 + x
+ *   s2'   = omega s1 + sigma s2
+ * with g1 = b1 - b0 a1 and g2 = (b2 - b0 a2 + g1 sigma) / omega.
+ */
+typedef struct {
+    float b0, g1, g2;
+    float sigma, omega;
+    float s1, s2;
+} iirdsp_coupled_section_t;
+
+/**
+ * Float cascade of DF2T and coupled-form sections
+ *
+ * Position i uses coupled[i] if is_coupled[i], else df2t[i].
+ */
+typedef struct {
+    iirdsp_biquad_f32_t df2t[IIRDSP_MAX_SECTIONS];
+    iirdsp_coupled_section_t coupled[IIRDSP_MAX_SECTIONS];
+    unsigned char is_coupled[IIRDSP_MAX_SECTIONS];
+    int num_sections;
+    int num_coupled;
+} iirdsp_coupled_t;
+
+/**
+ * Build a float cascade from a designed filter, choosing each structure
+ *
+ * Sections with a complex pole pair of radius at least min_coupled_radius
+ * use the coupled form; real-pole and first-order sections, and those
+ * further from the unit circle, stay DF2T. min_coupled_radius = 0 makes
+ * every complex-pole section coupled, > 1 none. State is zeroed.
+ *
+ * With IIRDSP_USE_FLOAT the designed coefficients are already float, so
+ * the coupled poles are only as exact as the float a1, a2; the roundoff
+ * gain is still removed.
+ *
+ * @param c Cascade to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param min_coupled_radius Smallest pole radius given the coupled form
+ *                           (e.g. IIRDSP_COUPLED_DEFAULT_RADIUS)
+ * @return Number of coupled sections
+ */
+int iirdsp_coupled_init(iirdsp_coupled_t* c, const iirdsp_filter_t* f, double min_coupled_radius);
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param c Cascade
+ */
+void iirdsp_coupled_reset(iirdsp_coupled_t* c);
+
+/**
+ * Process a single float sample
+ *
+ * @param c Cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+float iirdsp_coupled_process_sample(iirdsp_coupled_t* c, float x);
+
+/**
+ * Process a float buffer
+ *
+ * @param c Cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_coupled_process_buffer(iirdsp_coupled_t* c, const float* x, float* y, int N);
+
+/**
+ * Measure the output error against the designed filter
+ *
+ * Same measurement as iirdsp_mixed_measure_error: deterministic
+ * float-representable white noise through c and through a copy of f,
+ * RMS(error) / RMS(reference output). c is reset before and after.
+ *
+ * @param c Cascade
+ * @param f Designed filter c was built from
+ * @param num_samples Length of the test signal
+ * @return Relative RMS error
+ */
+double iirdsp_coupled_measure_error(iirdsp_coupled_t* c, const iirdsp_filter_t* f, int num_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_COUPLED_H */
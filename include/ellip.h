@@ -0,0 +1,101 @@
+/**
+ * @file ellip.h
+ * @brief Elliptic (Cauer) IIR filter design
+ *
+ * Elliptic filters ripple in both the passband and the stopband and have
+ * the narrowest transition band of the classical designs for a given
+ * order: a specification that needs a Butterworth of order 13 is often
+ * met at order 4, i.e. 2 sections instead of 7 in the per-sample loop.
+ * The sections come from the same bilinear/pairing pipeline as the
+ * Butterworth designs.
+ *
+ * Error codes: -1 invalid order (or too many sections), -2 invalid
+ * frequencies, -3 invalid ripple or attenuation.
+ */
+
+#ifndef IIRDSP_ELLIP_H
+#define IIRDSP_ELLIP_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Design an elliptic low-pass filter
+ *
+ * The passband ripples between 0 and -rp_db dB, ending at cutoff_hz with
+ * -rp_db dB; past the transition band the response stays below -rs_db dB.
+ * For even orders the DC gain is -rp_db dB.
+ * Equivalent to scipy.signal.ellip(order, rp_db, rs_db, cutoff_hz, fs=fs_hz, btype='low', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS * 2.
+ * @param rp_db Passband ripple (dB, > 0)
+ * @param rs_db Minimum stopband attenuation (dB, > rp_db)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int ellip_lowpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design an elliptic high-pass filter
+ *
+ * Equivalent to scipy.signal.ellip(order, rp_db, rs_db, cutoff_hz, fs=fs_hz, btype='high', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS * 2.
+ * @param rp_db Passband ripple (dB, > 0)
+ * @param rs_db Minimum stopband attenuation (dB, > rp_db)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int ellip_highpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Design an elliptic band-pass filter
+ *
+ * Equivalent to scipy.signal.ellip(order, rp_db, rs_db, [f_low, f_high], fs=fs_hz, btype='band', output='sos')
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (analog prototype). Max order is IIRDSP_MAX_SECTIONS (band-pass produces 2*order poles).
+ * @param rp_db Passband ripple (dB, > 0)
+ * @param rs_db Minimum stopband attenuation (dB, > rp_db)
+ * @param f_low_hz Low passband edge (Hz)
+ * @param f_high_hz High passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int ellip_bandpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_ELLIP_H */
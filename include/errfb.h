@@ -0,0 +1,128 @@
+/**
+ * @file errfb.h
+ * @brief Float cascade with error feedback on sections near the unit circle
+ *
+ * An alternative to changing structure (coupled.h) or precision (mixed.h):
+ * a float Direct Form I section that carries its own rounding error. Each
+ * sample the recursion sum is formed with error-free transformations (fmaf
+ * for products, two-sum for additions), so its float result s and the
+ * float residual d add up to the exact sum. The residual e of the stored
+ * output y and the low parts of a1, a2 are fed back through the poles on
+ * the next samples (second-order error feedback), which removes the
+ * 1 / |A(z)| roundoff gain that makes low cutoffs fail in float.
+ *
+ * Independent of IIRDSP_USE_FLOAT: everything runs in float. a1 and a2
+ * are split into float high and low parts from the designed section.
+ */
+
+#ifndef IIRDSP_ERRFB_H
+#define IIRDSP_ERRFB_H
+
+#include "config.h"
+#include "sos.h"
+#include "mixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default smallest pole radius given error feedback (same split point as
+ * the mixed cascade)
+ */
+#define IIRDSP_ERRFB_DEFAULT_RADIUS IIRDSP_MIXED_DEFAULT_RADIUS
+
+/**
+ * Float Direct Form I section with error feedback
+ *
+ * With y[n] + e[n] standing for the exact output:
+ *   s + d = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2      (exact)
+ *   c     = d - a1 e1 - a2 e2 - a1_lo y1 - a2_lo y2
+ *   y + e = s + c                                      (exact)
+ */
+typedef struct {
+    float b0, b1, b2;
+    float a1, a2;
+    float a1_lo, a2_lo;     /**< Designed a1, a2 minus their float parts */
+    float x1, x2;           /**< Input history */
+    float y1, y2;           /**< Output history */
+    float e1, e2;           /**< Output residual history */
+} iirdsp_errfb_section_t;
+
+/**
+ * Float cascade of DF2T and error-feedback sections
+ *
+ * Position i uses fb[i] if has_feedback[i], else df2t[i].
+ */
+typedef struct {
+    iirdsp_biquad_f32_t df2t[IIRDSP_MAX_SECTIONS];
+    iirdsp_errfb_section_t fb[IIRDSP_MAX_SECTIONS];
+    unsigned char has_feedback[IIRDSP_MAX_SECTIONS];
+    int num_sections;
+    int num_feedback;
+} iirdsp_errfb_t;
+
+/**
+ * Build a float cascade from a designed filter, choosing error feedback
+ * per section
+ *
+ * Sections whose iirdsp_section_pole_radius is at least
+ * min_feedback_radius get error feedback, the rest stay float DF2T.
+ * min_feedback_radius = 0 gives every section feedback, > 1 none. State
+ * is zeroed.
+ *
+ * With IIRDSP_USE_FLOAT the designed a1, a2 are already float, so their
+ * low parts are zero; the roundoff gain is still removed.
+ *
+ * @param c Cascade to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param min_feedback_radius Smallest pole radius given error feedback
+ *                            (e.g. IIRDSP_ERRFB_DEFAULT_RADIUS)
+ * @return Number of sections with error feedback
+ */
+int iirdsp_errfb_init(iirdsp_errfb_t* c, const iirdsp_filter_t* f, double min_feedback_radius);
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param c Cascade
+ */
+void iirdsp_errfb_reset(iirdsp_errfb_t* c);
+
+/**
+ * Process a single float sample
+ *
+ * @param c Cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+float iirdsp_errfb_process_sample(iirdsp_errfb_t* c, float x);
+
+/**
+ * Process a float buffer
+ *
+ * @param c Cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_errfb_process_buffer(iirdsp_errfb_t* c, const float* x, float* y, int N);
+
+/**
+ * Measure the output error against the designed filter
+ *
+ * Same measurement as iirdsp_mixed_measure_error. c is reset before and
+ * after.
+ *
+ * @param c Cascade
+ * @param f Designed filter c was built from
+ * @param num_samples Length of the test signal
+ * @return Relative RMS error
+ */
+double iirdsp_errfb_measure_error(iirdsp_errfb_t* c, const iirdsp_filter_t* f, int num_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_ERRFB_H */
@@ -0,0 +1,108 @@
+/**
+ * @file goertzel.h
+ * @brief Block-wise Goertzel tone power monitor
+ *
+ * Estimates the power of a few fixed tones (mains at 50/60 Hz and its
+ * harmonics) over consecutive blocks, to decide whether a channel needs a
+ * notch at all. Each bin is the second-order resonator
+ *   s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2]
+ * evaluated once at the end of the block, |X(w)|^2 = s1^2 + s2^2 -
+ * 2 cos(w) s1 s2: one multiply-add and one subtraction per bin per
+ * sample against five multiply-adds per notch section. The bins are independent, so they are run side by side
+ * in vector lanes.
+ *
+ * The block is rectangular: with block_size * f / fs an integer for every
+ * bin, steady tones at the bin frequencies do not leak into each other.
+ * Longer blocks leak less from the signal band (e.g. the ECG) into the
+ * mains bins.
+ */
+
+#ifndef IIRDSP_GOERTZEL_H
+#define IIRDSP_GOERTZEL_H
+
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum number of monitored frequencies
+ */
+#define IIRDSP_GOERTZEL_MAX_BINS 16
+
+/**
+ * Goertzel monitor
+ *
+ * power[] and total_power describe the last completed block (zero before
+ * the first); s1/s2 are padded to IIRDSP_GOERTZEL_MAX_BINS lanes.
+ */
+typedef struct {
+    iirdsp_real coef[IIRDSP_GOERTZEL_MAX_BINS];     /* 2 cos(2 pi f / fs) */
+    iirdsp_real s1[IIRDSP_GOERTZEL_MAX_BINS];
+    iirdsp_real s2[IIRDSP_GOERTZEL_MAX_BINS];
+    iirdsp_real power[IIRDSP_GOERTZEL_MAX_BINS];    /* Mean-square power of each tone */
+    iirdsp_real total_power;                        /* Mean square of the whole block */
+    iirdsp_real energy;                             /* Running sum of x^2 */
+    int num_bins;
+    int block_size;
+    int count;                                      /* Samples into the current block */
+} iirdsp_goertzel_t;
+
+/**
+ * Initialize a monitor for a set of frequencies
+ *
+ * @param g Monitor to initialize
+ * @param freqs_hz Frequencies to monitor (Hz), each in (0, fs_hz / 2)
+ * @param num_bins Number of frequencies (1..IIRDSP_GOERTZEL_MAX_BINS)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param block_size Samples per estimate (>= 2)
+ * @return 0 on success, -1 for an invalid bin count, -2 for an invalid
+ *         frequency, -3 for an invalid block size
+ */
+int iirdsp_goertzel_init(
+    iirdsp_goertzel_t* g,
+    const iirdsp_real* freqs_hz,
+    int num_bins,
+    iirdsp_real fs_hz,
+    int block_size
+);
+
+/**
+ * Reset state (discard the current block and the last estimates)
+ *
+ * @param g Monitor
+ */
+void iirdsp_goertzel_reset(iirdsp_goertzel_t* g);
+
+/**
+ * Feed samples (streaming)
+ *
+ * Blocks may span calls. power[] and total_power are updated each time a
+ * block completes.
+ *
+ * @param g Monitor
+ * @param x Input signal (length N)
+ * @param N Number of samples
+ * @return Number of blocks completed during this call
+ */
+int iirdsp_goertzel_process(iirdsp_goertzel_t* g, const iirdsp_real* x, int N);
+
+/**
+ * Fraction of the last block's power in one bin
+ *
+ * A steady tone of amplitude A at a bin frequency gives power A^2 / 2, so
+ * a sine-only input gives 1.
+ *
+ * @param g Monitor
+ * @param bin Bin index
+ * @return power[bin] / total_power, or 0 before the first block or for a
+ *         silent block
+ */
+iirdsp_real iirdsp_goertzel_fraction(const iirdsp_goertzel_t* g, int bin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_GOERTZEL_H */
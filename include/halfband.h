@@ -0,0 +1,233 @@
+/**
+ * @file halfband.h
+ * @brief Polyphase allpass half-band filters for 2x rate changes
+ *
+ * A half-band low-pass built from two allpass branches in z^2,
+ *   H(z) = (A0(z^2) + z^-1 A1(z^2)) / 2,
+ *   Ai(z^2) = prod (a_k + z^-2) / (1 + a_k z^-2),
+ * runs each branch at the low rate, so a first-order allpass section
+ * costs one multiply per low-rate sample. A 7-coefficient design (90 dB,
+ * transition band 0.05) decimates by 2 for 7 multiplies per output
+ * sample; a Butterworth low-pass with the same band edges needs order 39,
+ * about 200 multiplies per output sample before discarding.
+ *
+ * The coefficients come from the elliptic half-band design of Valenzuela
+ * and Constantinides: the stopband is equiripple above 0.25 + tbw / 2 of
+ * the high rate, the passband below 0.25 - tbw / 2 is flat to within the
+ * power-complementary ripple, and the phase is not linear.
+ */
+
+#ifndef IIRDSP_HALFBAND_H
+#define IIRDSP_HALFBAND_H
+
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum allpass coefficients per half-band stage
+ */
+#define IIRDSP_HALFBAND_MAX_COEFS 16
+
+/**
+ * Maximum stages in a multi-stage decimator or interpolator (factor 16)
+ */
+#define IIRDSP_HALFBAND_MAX_STAGES 4
+
+/**
+ * One half-band stage
+ *
+ * Even coefficients form the branch that sees the newer sample of each
+ * high-rate pair, odd coefficients the branch that sees the older one.
+ * x1/y1 hold each first-order allpass's previous low-rate input and output.
+ */
+typedef struct {
+    iirdsp_real coefs[IIRDSP_HALFBAND_MAX_COEFS];
+    iirdsp_real x1[IIRDSP_HALFBAND_MAX_COEFS];
+    iirdsp_real y1[IIRDSP_HALFBAND_MAX_COEFS];
+    int num_coefs;
+} iirdsp_halfband_t;
+
+/**
+ * Multi-stage decimator (factor 2^num_stages)
+ *
+ * Stage 0 runs at the input rate. A stage keeps the first sample of each
+ * pair until the second arrives, so buffers need not be a multiple of the
+ * factor.
+ */
+typedef struct {
+    iirdsp_halfband_t stages[IIRDSP_HALFBAND_MAX_STAGES];
+    iirdsp_real pending[IIRDSP_HALFBAND_MAX_STAGES];
+    unsigned char has_pending[IIRDSP_HALFBAND_MAX_STAGES];
+    int num_stages;
+} iirdsp_halfband_decimator_t;
+
+/**
+ * Multi-stage interpolator (factor 2^num_stages)
+ *
+ * Stage 0 runs at the input (lowest) rate.
+ */
+typedef struct {
+    iirdsp_halfband_t stages[IIRDSP_HALFBAND_MAX_STAGES];
+    int num_stages;
+} iirdsp_halfband_interpolator_t;
+
+/**
+ * Design half-band allpass coefficients for a stopband attenuation
+ *
+ * Picks the smallest odd filter order whose stopband above
+ * (0.25 + transition / 2) * fs reaches atten_db, and returns its
+ * (order - 1) / 2 allpass coefficients, all in (0, 1) and increasing.
+ *
+ * @param coefs Output coefficients (at least max_coefs)
+ * @param max_coefs Capacity of coefs
+ * @param atten_db Stopband attenuation (dB, > 0)
+ * @param transition Transition band width as a fraction of the high rate,
+ *                   in (0, 0.5)
+ * @return Number of coefficients, -2 for an invalid attenuation or
+ *         transition width, -3 if more than max_coefs are needed
+ */
+int iirdsp_halfband_design(iirdsp_real* coefs, int max_coefs, iirdsp_real atten_db, iirdsp_real transition);
+
+/**
+ * Initialize one stage from a stopband specification
+ *
+ * @param h Stage to initialize (state is zeroed)
+ * @param atten_db Stopband attenuation (dB)
+ * @param transition Transition band width as a fraction of the high rate
+ * @return 0 on success, -2 for an invalid specification, -3 if the design
+ *         needs more than IIRDSP_HALFBAND_MAX_COEFS coefficients
+ */
+int iirdsp_halfband_init(iirdsp_halfband_t* h, iirdsp_real atten_db, iirdsp_real transition);
+
+/**
+ * Reset stage state (zero all history)
+ *
+ * @param h Stage
+ */
+void iirdsp_halfband_reset(iirdsp_halfband_t* h);
+
+/**
+ * Filter one high-rate pair and return the low-rate sample
+ *
+ * @param h Stage
+ * @param x0 Older input sample
+ * @param x1 Newer input sample
+ * @return Low-pass filtered output at half the rate
+ */
+iirdsp_real iirdsp_halfband_decimate(iirdsp_halfband_t* h, iirdsp_real x0, iirdsp_real x1);
+
+/**
+ * Filter one low-rate sample into a high-rate pair
+ *
+ * Unity passband gain (the zero-stuffing loss of 2 is made up).
+ *
+ * @param h Stage
+ * @param x Input sample
+ * @param y Output pair, y[0] first in time
+ */
+void iirdsp_halfband_interpolate(iirdsp_halfband_t* h, iirdsp_real x, iirdsp_real* y);
+
+/**
+ * Initialize a multi-stage decimator
+ *
+ * The last stage, which sets the final passband, is designed for
+ * (atten_db, transition) at its own input rate. Each earlier stage only
+ * has to keep what would alias into the final passband out of it, so it
+ * is designed for the same attenuation with transition
+ * 0.25 + (next stage's transition) / 2, which needs far fewer
+ * coefficients. The passband ends at (0.25 - transition / 2) of the last
+ * stage's input rate.
+ *
+ * @param d Decimator to initialize (state is zeroed)
+ * @param num_stages Number of halvings (1..IIRDSP_HALFBAND_MAX_STAGES)
+ * @param atten_db Stopband attenuation (dB)
+ * @param transition Transition band width of the last stage, as a
+ *                   fraction of its input rate
+ * @return 0 on success, -1 for an invalid stage count, -2 for an invalid
+ *         specification, -3 if a stage needs more than
+ *         IIRDSP_HALFBAND_MAX_COEFS coefficients
+ */
+int iirdsp_halfband_decimator_init(
+    iirdsp_halfband_decimator_t* d,
+    int num_stages,
+    iirdsp_real atten_db,
+    iirdsp_real transition
+);
+
+/**
+ * Reset decimator state (zero all history and pending samples)
+ *
+ * @param d Decimator
+ */
+void iirdsp_halfband_decimator_reset(iirdsp_halfband_decimator_t* d);
+
+/**
+ * Decimate a buffer (streaming)
+ *
+ * @param d Decimator
+ * @param x Input signal (length N)
+ * @param N Number of input samples
+ * @param y Output signal (at least N / 2^num_stages + 1 samples), may
+ *          alias x
+ * @return Number of output samples written
+ */
+int iirdsp_halfband_decimator_process(
+    iirdsp_halfband_decimator_t* d,
+    const iirdsp_real* x,
+    int N,
+    iirdsp_real* y
+);
+
+/**
+ * Initialize a multi-stage interpolator
+ *
+ * Mirror image of iirdsp_halfband_decimator_init: stage 0, at the lowest
+ * rate, is designed for (atten_db, transition) and sets the passband;
+ * later stages use the wider transition bands.
+ *
+ * @param u Interpolator to initialize (state is zeroed)
+ * @param num_stages Number of doublings (1..IIRDSP_HALFBAND_MAX_STAGES)
+ * @param atten_db Stopband attenuation (dB)
+ * @param transition Transition band width of stage 0, as a fraction of
+ *                   its output rate
+ * @return 0 on success, -1 for an invalid stage count, -2 for an invalid
+ *         specification, -3 if a stage needs more than
+ *         IIRDSP_HALFBAND_MAX_COEFS coefficients
+ */
+int iirdsp_halfband_interpolator_init(
+    iirdsp_halfband_interpolator_t* u,
+    int num_stages,
+    iirdsp_real atten_db,
+    iirdsp_real transition
+);
+
+/**
+ * Reset interpolator state (zero all history)
+ *
+ * @param u Interpolator
+ */
+void iirdsp_halfband_interpolator_reset(iirdsp_halfband_interpolator_t* u);
+
+/**
+ * Interpolate a buffer (streaming)
+ *
+ * @param u Interpolator
+ * @param x Input signal (length N)
+ * @param N Number of input samples
+ * @param y Output signal (length N * 2^num_stages), must not alias x
+ */
+void iirdsp_halfband_interpolator_process(
+    iirdsp_halfband_interpolator_t* u,
+    const iirdsp_real* x,
+    int N,
+    iirdsp_real* y
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_HALFBAND_H */
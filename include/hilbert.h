@@ -0,0 +1,121 @@
+/**
+ * @file hilbert.h
+ * @brief Streaming IIR Hilbert transformer (allpass pair) and envelope
+ *
+ * Two allpass cascades whose phases differ by 90 degrees across
+ * [f_low, fs/2 - f_low] give the in-phase (I) and quadrature (Q) parts of
+ * the analytic signal sample by sample; the envelope is sqrt(I^2 + Q^2).
+ * Unlike an FFT Hilbert transform there is no block, and the delay is
+ * the allpass group delay (a few samples in mid-band, rising towards
+ * f_low).
+ *
+ * The pair is the half-band design of halfband.h shifted by fs/4: each
+ * allpass (a + z^-2) / (1 + a z^-2) becomes (a - z^-2) / (1 - a z^-2), a
+ * biquad with b1 = a1 = 0, and the odd branch keeps its one-sample delay.
+ * The half-band stopband ripple 10^(-A/20) becomes a phase error of
+ * 2 asin(10^(-A/20)). Both branches are ordinary iirdsp_filter_t cascades
+ * run by iirdsp_process_sample.
+ */
+
+#ifndef IIRDSP_HILBERT_H
+#define IIRDSP_HILBERT_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allpass-pair Hilbert transformer
+ *
+ * Q lags I by 90 degrees, so I + jQ has only positive frequencies.
+ */
+typedef struct {
+    iirdsp_filter_t in_phase;       /* Even half-band coefficients */
+    iirdsp_filter_t quadrature;     /* Odd coefficients, after x_prev */
+    iirdsp_real x_prev;             /* One-sample delay ahead of quadrature */
+    iirdsp_real phase_error_deg;    /* Designed worst-case phase error */
+} iirdsp_hilbert_t;
+
+/**
+ * Design a Hilbert transformer for a band and phase accuracy
+ *
+ * The 90-degree band is [f_low_hz, fs_hz / 2 - f_low_hz]. Each halving of
+ * f_low_hz or of the phase error costs about one more section per branch.
+ * State is zeroed.
+ *
+ * @param h Hilbert transformer to initialize
+ * @param f_low_hz Lower band edge (Hz), in (0, fs_hz / 4)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param max_phase_error_deg Largest deviation from 90 degrees in the band
+ *                            (degrees, in (0, 90))
+ * @return 0 on success, -2 for an invalid band, -3 for an invalid phase
+ *         error or if a branch needs more than IIRDSP_MAX_SECTIONS sections
+ */
+int iirdsp_hilbert_init(
+    iirdsp_hilbert_t* h,
+    iirdsp_real f_low_hz,
+    iirdsp_real fs_hz,
+    iirdsp_real max_phase_error_deg
+);
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param h Hilbert transformer
+ */
+void iirdsp_hilbert_reset(iirdsp_hilbert_t* h);
+
+/**
+ * Process a single sample into I and Q
+ *
+ * @param h Hilbert transformer
+ * @param x Input sample
+ * @param i In-phase output
+ * @param q Quadrature output
+ */
+void iirdsp_hilbert_process_sample(iirdsp_hilbert_t* h, iirdsp_real x, iirdsp_real* i, iirdsp_real* q);
+
+/**
+ * Process a single sample into its envelope sqrt(I^2 + Q^2)
+ *
+ * @param h Hilbert transformer
+ * @param x Input sample
+ * @return Envelope sample
+ */
+iirdsp_real iirdsp_hilbert_envelope_sample(iirdsp_hilbert_t* h, iirdsp_real x);
+
+/**
+ * Process a buffer into I and Q
+ *
+ * @param h Hilbert transformer
+ * @param x Input signal (length N)
+ * @param i In-phase output (length N), may alias x
+ * @param q Quadrature output (length N)
+ * @param N Number of samples
+ */
+void iirdsp_hilbert_process_buffer(
+    iirdsp_hilbert_t* h,
+    const iirdsp_real* x,
+    iirdsp_real* i,
+    iirdsp_real* q,
+    int N
+);
+
+/**
+ * Process a buffer into its envelope
+ *
+ * @param h Hilbert transformer
+ * @param x Input signal (length N)
+ * @param env Envelope output (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_hilbert_envelope_buffer(iirdsp_hilbert_t* h, const iirdsp_real* x, iirdsp_real* env, int N);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_HILBERT_H */
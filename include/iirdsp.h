@@ -12,7 +12,22 @@
 #include "config.h"
 #include "sos.h"
 #include "butter.h"
+#include "cheby.h"
+#include "ellip.h"
 #include "notch.h"
+#include "response.h"
+#include "lookahead.h"
+#include "statespace.h"
+#include "multi.h"
+#include "tunable.h"
+#include "mixed.h"
+#include "coupled.h"
+#include "errfb.h"
+#include "parallel.h"
+#include "halfband.h"
+#include "hilbert.h"
+#include "goertzel.h"
+#include "qrs.h"
 
 /**
  * iirdsp version string
@@ -0,0 +1,129 @@
+/**
+ * @file lookahead.h
+ * @brief Scattered look-ahead biquad cascade for instruction-level parallelism
+ */
+
+#ifndef IIRDSP_LOOKAHEAD_H
+#define IIRDSP_LOOKAHEAD_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum look-ahead depth M (a power of two)
+ */
+#define IIRDSP_LOOKAHEAD_MAX_M 8
+
+/**
+ * Number of look-ahead factors for IIRDSP_LOOKAHEAD_MAX_M (log2)
+ */
+#define IIRDSP_LOOKAHEAD_MAX_STAGES 3
+
+/**
+ * One section in M-step scattered look-ahead form
+ *
+ * The section denominator A(z) = (1 - p1 z^-1)(1 - p2 z^-1) is multiplied
+ * (numerator and denominator) by the M-1 rotated copies of its poles:
+ *   D(z) = (1 - p1^M z^-M)(1 - p2^M z^-M) = 1 + c1 z^-M + c2 z^-2M
+ * The added poles p*e^(j*2*pi*k/M) have the same radius as the original
+ * ones, so the transform is stable whenever the section is, and they are
+ * cancelled exactly by matching zeros.
+ *
+ * For M = 2^L the extra numerator factors into L sparse three-tap stages
+ *   D(z)/A(z) = prod_{k<L} (1 - alpha_k z^-2^k + beta_k z^-2^(k+1))
+ * so the section costs 3 + 2L multiplies of non-recursive work plus
+ *   y[n] = v[n] - c1 y[n-M] - c2 y[n-2M]
+ * in which M consecutive outputs are mutually independent.
+ */
+typedef struct {
+    iirdsp_real b0, b1, b2;                                /* Original numerator */
+    iirdsp_real alpha[IIRDSP_LOOKAHEAD_MAX_STAGES];        /* Look-ahead factors */
+    iirdsp_real beta[IIRDSP_LOOKAHEAD_MAX_STAGES];
+    iirdsp_real c1, c2;                                    /* Scattered denominator */
+    iirdsp_real x_hist[2];                                 /* Numerator stage input history */
+    iirdsp_real f_hist[2 * IIRDSP_LOOKAHEAD_MAX_M - 2];    /* Factor stage input histories */
+    iirdsp_real y_hist[2 * IIRDSP_LOOKAHEAD_MAX_M];        /* y[n-2M] .. y[n-1] */
+} iirdsp_lookahead_section_t;
+
+/**
+ * Cascade of look-ahead sections
+ */
+typedef struct {
+    iirdsp_lookahead_section_t sections[IIRDSP_MAX_SECTIONS];
+    int num_sections;
+    int M;           /* Look-ahead depth: 2, 4 or 8 */
+    int num_stages;  /* log2(M) */
+} iirdsp_lookahead_t;
+
+/**
+ * Build an M-step look-ahead form of a designed filter
+ *
+ * State is zeroed. Coefficients are derived in double precision.
+ *
+ * @param la Look-ahead cascade to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param M Look-ahead depth (2, 4 or 8)
+ * @return 0 on success, -1 for an unsupported M, -2 if the result is unstable
+ */
+int iirdsp_lookahead_init(iirdsp_lookahead_t* la, const iirdsp_filter_t* f, int M);
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param la Look-ahead cascade
+ */
+void iirdsp_lookahead_reset(iirdsp_lookahead_t* la);
+
+/**
+ * Process a buffer of samples through the look-ahead cascade
+ *
+ * Produces the same output as iirdsp_process_buffer on the source filter,
+ * up to rounding. x and y may alias.
+ *
+ * @param la Look-ahead cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_lookahead_process_buffer(
+    iirdsp_lookahead_t* la,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Check stability of every scattered denominator 1 + c1 w + c2 w^2
+ *
+ * @param la Look-ahead cascade
+ * @return 1 if all sections are stable, 0 otherwise
+ */
+int iirdsp_lookahead_is_stable(const iirdsp_lookahead_t* la);
+
+/**
+ * Measure the accuracy of a look-ahead cascade against the plain cascade
+ *
+ * Runs an impulse followed by a deterministic pseudo-random sequence
+ * through copies of both (neither argument is modified) and returns the
+ * largest absolute output difference.
+ *
+ * @param la Look-ahead cascade
+ * @param f Source filter
+ * @param N Number of test samples
+ * @return Maximum absolute error
+ */
+iirdsp_real iirdsp_lookahead_max_error(
+    const iirdsp_lookahead_t* la,
+    const iirdsp_filter_t* f,
+    int N
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_LOOKAHEAD_H */
@@ -0,0 +1,169 @@
+/**
+ * @file mixed.h
+ * @brief Mixed-precision cascade: float I/O, precision chosen per section
+ *
+ * Independent of IIRDSP_USE_FLOAT: a float section holds float
+ * coefficients and state and computes in float, a double section in
+ * double. Sections whose poles sit close
+ * to the unit circle (low cutoffs, narrow notches) lose most in float, so
+ * the split is made on pole radius when the cascade is built.
+ */
+
+#ifndef IIRDSP_MIXED_H
+#define IIRDSP_MIXED_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default largest pole radius run in float
+ *
+ * At 500 Hz this puts a 0.5 Hz high-pass (radius ~0.996) and a Q=30 50 Hz
+ * notch (~0.990) in double and a 40 Hz low-pass (0.6-0.8) in float.
+ */
+#define IIRDSP_MIXED_DEFAULT_RADIUS 0.99
+
+/**
+ * Biquad section in float
+ */
+typedef struct {
+    float b0, b1, b2;
+    float a1, a2;
+    float z1, z2;
+} iirdsp_biquad_f32_t;
+
+/**
+ * Biquad section in double
+ */
+typedef struct {
+    double b0, b1, b2;
+    double a1, a2;
+    double z1, z2;
+} iirdsp_biquad_f64_t;
+
+/**
+ * Mixed-precision cascade over caller-provided section storage
+ *
+ * Each section is stored once, in its own precision: double sections in
+ * wide[] and float sections in narrow[], each in cascade order, with
+ * is_double[] giving the precision of each position. The caller sizes
+ * the two arrays (iirdsp_mixed_num_double), so an ECG chain with two
+ * double and two float sections takes 2 x 56 + 2 x 28 bytes of sections
+ * plus this 40-byte header on LP64, against 456 bytes for a double
+ * iirdsp_filter_t. The cascade only points at the storage; it never
+ * allocates.
+ *
+ *   iirdsp_biquad_f64_t wide[2];      (iirdsp_mixed_num_double(&f, r) == 2)
+ *   iirdsp_biquad_f32_t narrow[2];
+ *   iirdsp_mixed_t m;
+ *   iirdsp_mixed_attach(&m, wide, 2, narrow, 2);
+ *   iirdsp_mixed_init(&m, &f, IIRDSP_MIXED_DEFAULT_RADIUS);
+ */
+typedef struct {
+    iirdsp_biquad_f64_t* wide;      /* Caller storage for double sections */
+    iirdsp_biquad_f32_t* narrow;    /* Caller storage for float sections */
+    int max_wide;                   /* Capacity of wide[] */
+    int max_narrow;                 /* Capacity of narrow[] */
+    unsigned char is_double[IIRDSP_MAX_SECTIONS];
+    int num_sections;
+    int num_double;
+} iirdsp_mixed_t;
+
+/**
+ * Attach a mixed cascade to caller storage (no sections in use yet)
+ *
+ * @param m Mixed cascade
+ * @param wide Double section storage, max_wide entries, must outlive m
+ * @param max_wide Capacity of wide
+ * @param narrow Float section storage, max_narrow entries, must outlive m
+ * @param max_narrow Capacity of narrow
+ */
+void iirdsp_mixed_attach(
+    iirdsp_mixed_t* m,
+    iirdsp_biquad_f64_t* wide,
+    int max_wide,
+    iirdsp_biquad_f32_t* narrow,
+    int max_narrow
+);
+
+/**
+ * Number of sections of a filter that would run in double
+ *
+ * The float sections are f->num_sections minus this.
+ *
+ * @param f Designed filter
+ * @param max_float_radius Largest pole radius run in float
+ * @return Number of double sections
+ */
+int iirdsp_mixed_num_double(const iirdsp_filter_t* f, double max_float_radius);
+
+/**
+ * Build a mixed-precision cascade from a designed filter
+ *
+ * Sections whose iirdsp_section_pole_radius exceeds max_float_radius run
+ * in double, the rest in float. max_float_radius = 0 gives double coefficients and
+ * accumulation throughout with float I/O only; >= 1 puts every stable
+ * section in float. State is zeroed.
+ *
+ * Meant for the default double build: with IIRDSP_USE_FLOAT the designed
+ * coefficients are already float, so double sections gain little.
+ *
+ * @param m Mixed cascade, attached to storage
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param max_float_radius Largest pole radius run in float
+ *                         (e.g. IIRDSP_MIXED_DEFAULT_RADIUS)
+ * @return Number of double sections, or -1 if the attached storage is
+ *         too small (m is then left empty)
+ */
+int iirdsp_mixed_init(iirdsp_mixed_t* m, const iirdsp_filter_t* f, double max_float_radius);
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param m Mixed cascade
+ */
+void iirdsp_mixed_reset(iirdsp_mixed_t* m);
+
+/**
+ * Process a single float sample
+ *
+ * @param m Mixed cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+float iirdsp_mixed_process_sample(iirdsp_mixed_t* m, float x);
+
+/**
+ * Process a float buffer
+ *
+ * @param m Mixed cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_mixed_process_buffer(iirdsp_mixed_t* m, const float* x, float* y, int N);
+
+/**
+ * Measure the output error against the designed filter
+ *
+ * Runs num_samples of deterministic white noise through m and through a
+ * copy of f and returns RMS(error) / RMS(reference output). The noise is
+ * float-representable, so the reference sees the same input. m is reset
+ * before and after.
+ *
+ * @param m Mixed cascade
+ * @param f Designed filter m was built from
+ * @param num_samples Length of the test signal
+ * @return Relative RMS error
+ */
+double iirdsp_mixed_measure_error(iirdsp_mixed_t* m, const iirdsp_filter_t* f, int num_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_MIXED_H */
@@ -0,0 +1,110 @@
+/**
+ * @file multi.h
+ * @brief Multichannel cascade: many channels, shared or per-channel designs
+ */
+
+#ifndef IIRDSP_MULTI_H
+#define IIRDSP_MULTI_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum number of channels in one multichannel cascade
+ */
+#define IIRDSP_MULTI_MAX_CHANNELS 64
+
+/**
+ * Multichannel cascade with per-channel coefficients
+ *
+ * Coefficients and state are stored structure-of-arrays
+ * (b0[section][channel], z1[section][channel], ...), so one frame of
+ * interleaved input maps directly onto vector lanes and every lane may
+ * run a different filter. Channels whose design has fewer sections than
+ * the longest one are padded with identity sections (b0 = 1), so a
+ * heterogeneous bank still runs at full vector width.
+ */
+typedef struct {
+    int num_sections;  /* Longest cascade in the bank */
+    int num_channels;
+    iirdsp_real b0[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+    iirdsp_real b1[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+    iirdsp_real b2[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+    iirdsp_real a1[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+    iirdsp_real a2[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+    iirdsp_real z1[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+    iirdsp_real z2[IIRDSP_MAX_SECTIONS][IIRDSP_MULTI_MAX_CHANNELS];
+} iirdsp_multi_t;
+
+/**
+ * Initialize a multichannel cascade with one design for all channels
+ *
+ * State is zeroed.
+ *
+ * @param m Multichannel cascade to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param num_channels Number of channels (1..IIRDSP_MULTI_MAX_CHANNELS)
+ * @return 0 on success, -1 for an invalid channel count
+ */
+int iirdsp_multi_init(iirdsp_multi_t* m, const iirdsp_filter_t* f, int num_channels);
+
+/**
+ * Initialize a multichannel cascade with a design per channel
+ *
+ * Channel c runs filters[c]; entries may point to the same design, e.g.
+ * one notch shared by a channel group. Shorter cascades are padded with
+ * identity sections. State is zeroed.
+ *
+ * @param m Multichannel cascade to initialize
+ * @param filters Array of num_channels designed filters (state is ignored)
+ * @param num_channels Number of channels (1..IIRDSP_MULTI_MAX_CHANNELS)
+ * @return 0 on success, -1 for an invalid channel count
+ */
+int iirdsp_multi_init_bank(
+    iirdsp_multi_t* m,
+    const iirdsp_filter_t* const* filters,
+    int num_channels
+);
+
+/**
+ * Reset state of all channels
+ *
+ * @param m Multichannel cascade
+ */
+void iirdsp_multi_reset(iirdsp_multi_t* m);
+
+/**
+ * Process interleaved frames
+ *
+ * Sample n of channel c is at x[n * num_channels + c]. Each channel gives
+ * the same output as its own iirdsp_filter_t, up to rounding. x and y
+ * may alias.
+ *
+ * @param m Multichannel cascade
+ * @param x Interleaved input (num_frames * num_channels samples)
+ * @param y Interleaved output (num_frames * num_channels samples)
+ * @param num_frames Number of frames
+ */
+void iirdsp_multi_process_interleaved(
+    iirdsp_multi_t* m,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int num_frames
+);
+
+/**
+ * Name of the kernel selected at compile time
+ *
+ * @return "sve", "avx512", "avx", "sse2", "neon" or "scalar"
+ */
+const char* iirdsp_multi_kernel_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_MULTI_H */
@@ -38,6 +38,201 @@ int notch_filter_init(
     iirdsp_real fs_hz
 );
 
+/**
+ * Maximum delay (samples) of an IIR comb, i.e. fs / f0
+ */
+#define IIRDSP_COMB_MAX_DELAY 512
+
+/**
+ * Design notches at a fundamental and its harmonics as one cascade
+ *
+ * Section k is notch_filter_init(k * f0_hz, Q, fs_hz), so the whole set
+ * runs in a single pass. With a common Q each notch is as wide relative
+ * to its frequency as mains drift is at that harmonic.
+ *
+ * @param f Filter structure to initialize (num_harmonics sections)
+ * @param f0_hz Fundamental frequency (Hz)
+ * @param num_harmonics Number of notches (1..IIRDSP_MAX_SECTIONS), at
+ *        f0_hz, 2 * f0_hz, ...
+ * @param Q Quality factor of every notch
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 for invalid parameters, -2 if the highest
+ *         harmonic is not below Nyquist
+ */
+int notch_comb_init(
+    iirdsp_filter_t* f,
+    iirdsp_real f0_hz,
+    int num_harmonics,
+    iirdsp_real Q,
+    iirdsp_real fs_hz
+);
+
+/**
+ * IIR comb notch (delay-line form)
+ *
+ * Equivalent to scipy.signal.iircomb(f0_hz, Q, ftype='notch', fs=fs_hz,
+ * pass_zero=...). With N = fs / f0:
+ *   pass_zero = 0: H(z) = b (1 - z^-N) / (1 - a z^-N), nulls at 0, f0, 2 f0, ...
+ *   pass_zero = 1: H(z) = b (1 + z^-N) / (1 + a z^-N), nulls at f0/2, 3 f0/2, ...
+ * so e.g. f0 = 100 Hz with pass_zero = 1 removes 50, 150, 250 Hz, ...
+ * Every null has the bandwidth f0 / Q. The cost is two multiplies per
+ * sample whatever the number of harmonics, and since the recursion
+ * reaches back N samples, blocks of up to N samples are independent and
+ * the buffer loop vectorizes.
+ */
+typedef struct {
+    iirdsp_real b;      /* Numerator gain */
+    iirdsp_real a;      /* Feedback coefficient */
+    iirdsp_real sign;   /* -1 (nulls at k f0) or +1 (nulls at (k + 1/2) f0) */
+    int N;              /* Delay (samples) */
+    int pos;            /* Oldest entry of the delay line */
+    iirdsp_real w[IIRDSP_COMB_MAX_DELAY];  /* Delay line w[n-N] .. w[n-1] */
+} iirdsp_comb_t;
+
+/**
+ * Design an IIR comb notch
+ *
+ * @param c Comb to initialize (state zeroed)
+ * @param f0_hz Comb spacing (Hz); fs_hz / f0_hz must be an integer
+ *        no larger than IIRDSP_COMB_MAX_DELAY
+ * @param Q Quality factor (f0_hz / null bandwidth)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param pass_zero 0 for nulls at DC and multiples of f0_hz, 1 for nulls
+ *        halfway between (DC passes)
+ * @return 0 on success, -1 for invalid parameters, -2 if fs_hz / f0_hz is
+ *         not an integer in 2..IIRDSP_COMB_MAX_DELAY
+ */
+int iirdsp_comb_init(
+    iirdsp_comb_t* c,
+    iirdsp_real f0_hz,
+    iirdsp_real Q,
+    iirdsp_real fs_hz,
+    int pass_zero
+);
+
+/**
+ * Reset the delay line
+ *
+ * @param c Comb
+ */
+void iirdsp_comb_reset(iirdsp_comb_t* c);
+
+/**
+ * Filter one sample
+ *
+ * @param c Comb
+ * @param x Input sample
+ * @return Output sample
+ */
+iirdsp_real iirdsp_comb_process_sample(iirdsp_comb_t* c, iirdsp_real x);
+
+/**
+ * Filter a buffer
+ *
+ * @param c Comb
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_comb_process_buffer(
+    iirdsp_comb_t* c,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Adaptive notch that tracks a drifting interference frequency
+ *
+ * Uses the notch_filter_init (iirnotch) section with the bandwidth term
+ * held fixed and c = cos(w0) adapted:
+ *   H(z) = g (1 - 2c z^-1 + z^-2) / (1 - (1 + k) c z^-1 + k z^-2)
+ * with k = (1 - alpha) / (1 + alpha), g = (1 + k) / 2. Only b1 = -2gc and
+ * a1 = -(1 + k) c change, so an update is one multiply-add. The section
+ * runs in direct form II so that the recursive state s[n-1], the gradient
+ * regressor, is at hand, and c follows a normalized LMS update
+ *   c += mu * e[n] * s[n-1] / P[n]
+ * where e is the notch output and P a running power of s. c is clamped
+ * to the frequency range given at init, so the notch cannot wander off
+ * to signal content outside it.
+ */
+typedef struct {
+    iirdsp_real c;             /* cos(w0), adapted */
+    iirdsp_real c_min, c_max;  /* Clamp range (from f_max_hz, f_min_hz) */
+    iirdsp_real k;             /* Pole radius squared */
+    iirdsp_real g;             /* Numerator gain (1 + k) / 2 */
+    iirdsp_real mu;            /* Normalized step size */
+    iirdsp_real power;         /* Running power of s[n-1] */
+    iirdsp_real s1, s2;        /* Direct form II state s[n-1], s[n-2] */
+    iirdsp_real fs_hz;
+} iirdsp_adaptive_notch_t;
+
+/**
+ * Initialize an adaptive notch
+ *
+ * With mu = 0 the filter is exactly notch_filter_init(f0_hz, Q, fs_hz).
+ * Since the notch follows the interference, Q can be far higher than for
+ * a fixed notch that has to cover the drift (e.g. 100-300 instead of 30).
+ *
+ * @param n Adaptive notch to initialize
+ * @param f0_hz Initial notch frequency (Hz)
+ * @param Q Quality factor
+ * @param f_min_hz Lowest frequency the notch may track to (Hz)
+ * @param f_max_hz Highest frequency the notch may track to (Hz)
+ * @param mu Adaptation step size (typically 1e-4 to 1e-2; 0 freezes)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 for invalid parameters, -2 for a frequency
+ *         range that is not inside (0, fs_hz / 2) or does not contain f0_hz
+ */
+int iirdsp_adaptive_notch_init(
+    iirdsp_adaptive_notch_t* n,
+    iirdsp_real f0_hz,
+    iirdsp_real Q,
+    iirdsp_real f_min_hz,
+    iirdsp_real f_max_hz,
+    iirdsp_real mu,
+    iirdsp_real fs_hz
+);
+
+/**
+ * Reset state, keeping the current frequency estimate
+ *
+ * @param n Adaptive notch
+ */
+void iirdsp_adaptive_notch_reset(iirdsp_adaptive_notch_t* n);
+
+/**
+ * Filter one sample and adapt the notch frequency
+ *
+ * @param n Adaptive notch
+ * @param x Input sample
+ * @return Output sample
+ */
+iirdsp_real iirdsp_adaptive_notch_process_sample(iirdsp_adaptive_notch_t* n, iirdsp_real x);
+
+/**
+ * Filter a buffer and adapt the notch frequency
+ *
+ * @param n Adaptive notch
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_adaptive_notch_process_buffer(
+    iirdsp_adaptive_notch_t* n,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Current notch frequency estimate
+ *
+ * @param n Adaptive notch
+ * @return Frequency (Hz)
+ */
+iirdsp_real iirdsp_adaptive_notch_frequency(const iirdsp_adaptive_notch_t* n);
+
 #ifdef __cplusplus
 }
 #endif
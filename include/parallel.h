@@ -0,0 +1,110 @@
+/**
+ * @file parallel.h
+ * @brief Parallel-form (partial fraction) realization of a designed filter
+ */
+
+#ifndef IIRDSP_PARALLEL_H
+#define IIRDSP_PARALLEL_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Sum of second-order sections plus a direct term
+ *
+ * The cascade H(z) = prod_i B_i(z) / A_i(z) is expanded in partial
+ * fractions, keeping each section's pole pair together:
+ *
+ *   H(z) = direct + sum_i (g0_i + g1_i z^-1) / (1 + a1_i z^-1 + a2_i z^-2)
+ *
+ * Every section sees the same input, so the sections are independent and
+ * run side by side in vector lanes; per sample the critical path is one
+ * section instead of the whole chain. Coefficients are stored one array
+ * per coefficient, padded with zero sections to IIRDSP_MAX_SECTIONS.
+ */
+typedef struct {
+    iirdsp_real g0[IIRDSP_MAX_SECTIONS];  /* Numerators (first order) */
+    iirdsp_real g1[IIRDSP_MAX_SECTIONS];
+    iirdsp_real a1[IIRDSP_MAX_SECTIONS];  /* Denominators, as in the cascade */
+    iirdsp_real a2[IIRDSP_MAX_SECTIONS];
+    iirdsp_real z1[IIRDSP_MAX_SECTIONS];  /* DF2T state */
+    iirdsp_real z2[IIRDSP_MAX_SECTIONS];
+    iirdsp_real direct;                   /* Feed-through term */
+    int num_sections;
+} iirdsp_parallel_t;
+
+/**
+ * Convert a designed cascade to parallel form
+ *
+ * Residues are computed in double precision from the section poles.
+ * Partial fractions need distinct poles, and no section may have a
+ * numerator of higher degree than its denominator (true of every
+ * butter_*_init and notch design). State is zeroed.
+ *
+ * Clustered poles (high orders at very low cutoffs) give large residues
+ * that cancel in the sum, so the realization can lose accuracy; check it
+ * with iirdsp_parallel_response_error.
+ *
+ * @param p Parallel form to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @return 0 on success, -1 if a section is improper, -2 on repeated poles
+ */
+int iirdsp_parallel_init(iirdsp_parallel_t* p, const iirdsp_filter_t* f);
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param p Parallel form
+ */
+void iirdsp_parallel_reset(iirdsp_parallel_t* p);
+
+/**
+ * Process a single sample
+ *
+ * @param p Parallel form
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+iirdsp_real iirdsp_parallel_process_sample(iirdsp_parallel_t* p, iirdsp_real x);
+
+/**
+ * Process a buffer of samples
+ *
+ * @param p Parallel form
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_parallel_process_buffer(
+    iirdsp_parallel_t* p,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Accuracy of the parallel form against the cascade it came from
+ *
+ * Evaluates both frequency responses on num_freqs points from DC to
+ * Nyquist and returns max |H_parallel - H_cascade| / max |H_cascade|.
+ *
+ * @param p Parallel form
+ * @param f Cascade p was built from
+ * @param num_freqs Number of frequency points (>= 2)
+ * @return Relative peak deviation
+ */
+iirdsp_real iirdsp_parallel_response_error(
+    const iirdsp_parallel_t* p,
+    const iirdsp_filter_t* f,
+    int num_freqs
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_PARALLEL_H */
@@ -0,0 +1,150 @@
+/**
+ * @file qrs.h
+ * @brief Streaming QRS detector (Pan-Tompkins)
+ *
+ * Finds R peaks in a single ECG lead one sample at a time. Each input
+ * sample goes through the whole Pan-Tompkins chain before the next one
+ * is read: 5-15 Hz Butterworth band-pass (an ordinary SOS cascade),
+ * five-point derivative, squaring, and a 150 ms moving-window integral.
+ * No intermediate buffers are needed.
+ *
+ * Peaks of the integral are classified against adaptive signal and noise
+ * levels (SPKI / NPKI):
+ *   - a 200 ms refractory period after each beat;
+ *   - T-wave rejection within 360 ms of a beat when the slope is less
+ *     than half that of the previous QRS;
+ *   - search-back at half the threshold when no beat is found within
+ *     1.66 times the mean RR interval.
+ * The first two seconds set the initial levels and produce no beats.
+ *
+ * Beats are reported late: the search-back can only name a beat once the
+ * expected interval has passed. r_index is the position of the R peak in
+ * the input, compensated for the delay of the band-pass (at 10 Hz), the
+ * derivative and the integrator.
+ */
+
+#ifndef IIRDSP_QRS_H
+#define IIRDSP_QRS_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum moving-window length (150 ms at up to 1700 Hz)
+ */
+#define IIRDSP_QRS_MAX_WINDOW 256
+
+/**
+ * Number of RR intervals averaged for the search-back limit and heart rate
+ */
+#define IIRDSP_QRS_RR_HISTORY 8
+
+/**
+ * QRS detector
+ *
+ * All sample positions count input samples since the last reset.
+ */
+typedef struct {
+    iirdsp_filter_t bandpass;                       /* 5-15 Hz */
+    iirdsp_real bp_hist[4];                         /* Band-passed x[n-1..n-4] */
+    iirdsp_real window[IIRDSP_QRS_MAX_WINDOW];      /* Squared slope ring */
+    iirdsp_real window_sum;
+    int window_len;
+    int window_pos;
+
+    /* Peak of the integral currently being tracked */
+    iirdsp_real prev_mwi;
+    iirdsp_real peak;
+    iirdsp_real peak_slope;                         /* Largest squared slope on the way up */
+    long peak_index;
+
+    /* Adaptive levels */
+    iirdsp_real spki;                               /* Signal level */
+    iirdsp_real npki;                               /* Noise level */
+    iirdsp_real last_qrs_slope;
+
+    /* Best rejected peak since the last beat, for search-back */
+    iirdsp_real backup_peak;
+    iirdsp_real backup_slope;
+    long backup_index;
+
+    int rr[IIRDSP_QRS_RR_HISTORY];                  /* Recent RR intervals (samples) */
+    int rr_count;
+    int rr_mean;
+
+    long last_qrs;                                  /* Integral peak index of the last beat */
+    long n;                                         /* Samples processed */
+
+    int learn_len;                                  /* Samples in the learning phase */
+    int refractory;                                 /* 200 ms */
+    int t_wave_window;                              /* 360 ms */
+    int delay;                                      /* Integral peak to R peak (samples) */
+    iirdsp_real fs;
+} iirdsp_qrs_t;
+
+/**
+ * Initialize a detector
+ *
+ * @param q Detector to initialize
+ * @param fs_hz Sampling frequency (Hz); 50 Hz up to the rate at which
+ *        150 ms fills IIRDSP_QRS_MAX_WINDOW samples
+ * @return 0 on success, -2 for an unsupported sampling frequency
+ */
+int iirdsp_qrs_init(iirdsp_qrs_t* q, iirdsp_real fs_hz);
+
+/**
+ * Reset state (restarts the learning phase and the sample count)
+ *
+ * @param q Detector
+ */
+void iirdsp_qrs_reset(iirdsp_qrs_t* q);
+
+/**
+ * Process a single sample
+ *
+ * @param q Detector
+ * @param x Input sample
+ * @param r_index Receives the input index of the R peak when a beat is
+ *        reported
+ * @return 1 if a beat is reported, 0 otherwise
+ */
+int iirdsp_qrs_process_sample(iirdsp_qrs_t* q, iirdsp_real x, long* r_index);
+
+/**
+ * Process a buffer (streaming)
+ *
+ * Beats beyond max_beats are detected (levels keep adapting) but not
+ * stored.
+ *
+ * @param q Detector
+ * @param x Input signal (length N)
+ * @param N Number of samples
+ * @param r_index Receives the R peak indices of reported beats
+ * @param max_beats Capacity of r_index
+ * @return Number of indices stored in r_index
+ */
+int iirdsp_qrs_process_buffer(
+    iirdsp_qrs_t* q,
+    const iirdsp_real* x,
+    int N,
+    long* r_index,
+    int max_beats
+);
+
+/**
+ * Heart rate from the mean of the recent RR intervals
+ *
+ * @param q Detector
+ * @return Beats per minute, or 0 before two beats have been detected
+ */
+iirdsp_real iirdsp_qrs_heart_rate(const iirdsp_qrs_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_QRS_H */
@@ -0,0 +1,212 @@
+/**
+ * @file response.h
+ * @brief Frequency-response analysis of SOS filters
+ */
+
+#ifndef IIRDSP_RESPONSE_H
+#define IIRDSP_RESPONSE_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Evaluate the frequency response of a filter at arbitrary frequencies
+ *
+ * For each frequency the cascade response H(e^jw) = prod_i B_i / A_i is
+ * evaluated together with its analytic group delay
+ *   tau(w) = sum_i Re{ z B_i'(z) / B_i(z) } - Re{ z A_i'(z) / A_i(z) }
+ * Frequencies are processed in blocks with e^-jw / e^-2jw computed once
+ * per frequency (not per section), and the per-section loop runs across
+ * the block so the compiler can vectorize the complex arithmetic.
+ *
+ * Equivalent to scipy.signal.sosfreqz(sos, worN=freqs_hz, fs=fs_hz)
+ * combined with scipy.signal.group_delay.
+ *
+ * At frequencies where a numerator section vanishes (zeros on the unit
+ * circle), the group delay of that section is undefined and set to 0.
+ *
+ * @param f Filter to evaluate
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param mag Output magnitude |H| (length num_freqs), may be NULL
+ * @param phase Output phase in radians, wrapped to [-pi, pi] (length num_freqs), may be NULL
+ * @param group_delay Output group delay in samples (length num_freqs), may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_sosfreqz(
+    const iirdsp_filter_t* f,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+);
+
+/**
+ * Evaluate the frequency response of a variable-size cascade
+ *
+ * Same as iirdsp_sosfreqz for an iirdsp_cascade_t.
+ *
+ * @param c Cascade to evaluate
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param mag Output magnitude |H| (length num_freqs), may be NULL
+ * @param phase Output phase in radians, wrapped to [-pi, pi] (length num_freqs), may be NULL
+ * @param group_delay Output group delay in samples (length num_freqs), may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_cascade_sosfreqz(
+    const iirdsp_cascade_t* c,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+);
+
+/**
+ * Evaluate the frequency response on a uniform grid from DC to Nyquist
+ *
+ * Grid points are f_k = k * fs / (2 * num_points), k = 0 .. num_points-1
+ * (Nyquist excluded), matching scipy.signal.sosfreqz(sos, worN=num_points).
+ * e^-jw is generated by a complex rotation recurrence, re-anchored to
+ * cos/sin every IIRDSP_FREQZ_BLOCK points to bound rounding drift.
+ *
+ * @param f Filter to evaluate
+ * @param num_points Number of grid points
+ * @param fs_hz Sampling frequency (Hz)
+ * @param freqs_hz Output grid frequencies (Hz), may be NULL
+ * @param mag Output magnitude |H|, may be NULL
+ * @param phase Output phase in radians, wrapped to [-pi, pi], may be NULL
+ * @param group_delay Output group delay in samples, may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_sosfreqz_grid(
+    const iirdsp_filter_t* f,
+    int num_points,
+    iirdsp_real fs_hz,
+    iirdsp_real* freqs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+);
+
+/**
+ * Group delay summary over a frequency band
+ *
+ * All delays are in samples. delay_spread = max_delay - min_delay measures
+ * the dispersion a causal filter introduces across the band; a
+ * zero-phase (filtfilt) implementation has none, at the cost of buffering.
+ */
+typedef struct {
+    iirdsp_real max_delay;     /* Worst-case group delay in the band */
+    iirdsp_real max_delay_hz;  /* Frequency where the worst case occurs (Hz) */
+    iirdsp_real min_delay;     /* Smallest group delay in the band */
+    iirdsp_real mean_delay;    /* Average group delay over the band */
+    iirdsp_real delay_spread;  /* max_delay - min_delay */
+} iirdsp_delay_summary_t;
+
+/**
+ * Group delay of a single section
+ *
+ * @param s Section to evaluate (state is not used)
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param group_delay Output group delay in samples (length num_freqs)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_section_group_delay(
+    const iirdsp_biquad_t* s,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* group_delay
+);
+
+/**
+ * Total group delay of the cascade (sum of the section delays)
+ *
+ * @param f Filter to evaluate
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param group_delay Output group delay in samples (length num_freqs)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_group_delay(
+    const iirdsp_filter_t* f,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* group_delay
+);
+
+/**
+ * Summarize group delay over a passband for latency budgeting
+ *
+ * Evaluates num_points evenly spaced frequencies from f_low_hz to
+ * f_high_hz inclusive. Memory use is fixed (no allocation), so num_points
+ * may be large.
+ *
+ * @param f Filter to evaluate
+ * @param f_low_hz Lower band edge (Hz), may be 0
+ * @param f_high_hz Upper band edge (Hz), must not exceed fs_hz / 2
+ * @param fs_hz Sampling frequency (Hz)
+ * @param num_points Number of evaluation points (>= 2)
+ * @param summary Output summary
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_passband_delay(
+    const iirdsp_filter_t* f,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz,
+    int num_points,
+    iirdsp_delay_summary_t* summary
+);
+
+/**
+ * Largest pole radius of a section
+ *
+ * Roots of z^2 + a1*z + a2. A section is stable when this is < 1; the
+ * closer to 1, the slower its impulse response decays.
+ *
+ * @param s Section to evaluate
+ * @return Largest |pole| of the section
+ */
+iirdsp_real iirdsp_section_pole_radius(const iirdsp_biquad_t* s);
+
+/**
+ * Estimate the impulse-response length of a filter
+ *
+ * Returns the number of samples after which |h[n]| stays below eps. The
+ * estimate comes from the poles of each section: every pole p contributes
+ * a mode R * p^n to h[n], where R is the residue of the whole cascade at p.
+ * The length is the first n at which the sum of the mode envelopes
+ * |R| r^n drops below eps, which bounds |h[n]| from then on. Repeated
+ * poles use an (n+1)*r^n envelope.
+ *
+ * Use it to size warm-up windows, chunk overlaps and filtfilt padding.
+ *
+ * @param f Filter to evaluate
+ * @param eps Absolute threshold on |h[n]| (e.g. 1e-6), > 0
+ * @return Length in samples, -1 if a pole is on or outside the unit circle,
+ *         -2 if eps is not positive, -3 if the length exceeds INT_MAX
+ *         (pole radius extremely close to 1)
+ */
+int iirdsp_impulse_length(const iirdsp_filter_t* f, iirdsp_real eps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_RESPONSE_H */
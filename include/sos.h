@@ -40,6 +40,56 @@ typedef struct {
     int num_sections;
 } iirdsp_filter_t;
 
+/**
+ * Variable-size cascade over caller-provided section storage
+ *
+ * Holds exactly as many sections as the caller gives it, with no
+ * IIRDSP_MAX_SECTIONS cap: a one-section notch needs one iirdsp_biquad_t,
+ * and an order-10 band-pass (10 sections) fits as well. The cascade only
+ * points at the storage; it never allocates.
+ *
+ *   iirdsp_biquad_t storage[10];
+ *   iirdsp_cascade_t c;
+ *   iirdsp_cascade_init(&c, storage, 10);
+ *   butter_bandpass_init_cascade(&c, 10, 5.0, 15.0, 500.0);
+ */
+typedef struct {
+    iirdsp_biquad_t* sections;  /* Caller storage */
+    int num_sections;           /* Sections in use */
+    int max_sections;           /* Capacity of sections[] */
+} iirdsp_cascade_t;
+
+/**
+ * Attach a cascade to caller storage (no sections in use yet)
+ *
+ * @param c Cascade
+ * @param storage Section storage, max_sections entries, must outlive c
+ * @param max_sections Capacity of storage
+ */
+static inline void iirdsp_cascade_init(
+    iirdsp_cascade_t* c,
+    iirdsp_biquad_t* storage,
+    int max_sections
+)
+{
+    c->sections = storage;
+    c->num_sections = 0;
+    c->max_sections = max_sections;
+}
+
+/**
+ * Reset cascade state (zero all state variables)
+ *
+ * @param c Cascade
+ */
+static inline void iirdsp_cascade_reset(iirdsp_cascade_t* c)
+{
+    for (int i = 0; i < c->num_sections; i++) {
+        c->sections[i].z1 = 0.0;
+        c->sections[i].z2 = 0.0;
+    }
+}
+
 /**
  * Initialize filter state (zero all state variables)
  *
@@ -84,6 +134,22 @@ static inline iirdsp_real iirdsp_process_sample(iirdsp_filter_t* f, iirdsp_real
     return y;
 }
 
+/**
+ * Process a single sample through a variable-size cascade
+ *
+ * @param c Cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+static inline iirdsp_real iirdsp_cascade_process_sample(iirdsp_cascade_t* c, iirdsp_real x)
+{
+    iirdsp_real y = x;
+    for (int i = 0; i < c->num_sections; i++) {
+        y = iirdsp_biquad_process(&c->sections[i], y);
+    }
+    return y;
+}
+
 /**
  * Reset filter state (zero all state variables)
  *
@@ -94,6 +160,23 @@ static inline void iirdsp_filter_reset(iirdsp_filter_t* f)
     iirdsp_filter_init(f);
 }
 
+/**
+ * Initialize filter state to the steady state for a constant input
+ *
+ * Sets z1/z2 of every section as if the input had been x0 forever, so the
+ * output is valid from the first sample instead of after the start-up
+ * transient. For section i with input u and DC gain
+ * G = (b0 + b1 + b2) / (1 + a1 + a2), the output is y = G*u and
+ *   z1 = y - b0*u
+ *   z2 = b2*u - a2*y
+ * Use the first sample of a new session as x0.
+ *
+ * @param f Filter pointer
+ * @param x0 Input level the filter is assumed to have settled on
+ * @return 0 on success, -1 if a section has a pole at DC (no steady state)
+ */
+int iirdsp_filter_init_steady(iirdsp_filter_t* f, iirdsp_real x0);
+
 /**
  * Process a buffer of samples through the filter
  *
@@ -109,6 +192,84 @@ void iirdsp_process_buffer(
     int N
 );
 
+/**
+ * Process a buffer of samples through a variable-size cascade
+ *
+ * @param c Cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_cascade_process_buffer(
+    iirdsp_cascade_t* c,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Process a buffer of int16 ADC samples through the filter
+ *
+ * Conversion to iirdsp_real (x[n] * scale) is fused into the filter loop:
+ * samples are converted in small blocks that stay in L1 cache, so no
+ * separate full-length iirdsp_real input buffer is needed.
+ *
+ * @param f Filter pointer
+ * @param x Input samples (length N)
+ * @param scale Conversion factor from ADC counts to iirdsp_real units
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_process_buffer_i16(
+    iirdsp_filter_t* f,
+    const int16_t* x,
+    iirdsp_real scale,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Process a buffer of packed 24-bit ADC samples through the filter
+ *
+ * Each sample occupies 3 bytes, little-endian, two's complement
+ * (the native output format of most 24-bit biopotential front-ends).
+ *
+ * @param f Filter pointer
+ * @param x Packed input samples (length 3*N bytes)
+ * @param scale Conversion factor from ADC counts to iirdsp_real units
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_process_buffer_i24(
+    iirdsp_filter_t* f,
+    const uint8_t* x,
+    iirdsp_real scale,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Process int16 samples in, int16 samples out
+ *
+ * Output is y[n] * out_scale, rounded to nearest and saturated to
+ * [-32768, 32767]; NaN is written as 0. x and y may alias.
+ *
+ * @param f Filter pointer
+ * @param x Input samples (length N)
+ * @param y Output samples (length N)
+ * @param in_scale Conversion factor from input counts to iirdsp_real units
+ * @param out_scale Conversion factor from iirdsp_real units to output counts
+ * @param N Number of samples
+ */
+void iirdsp_process_buffer_i16_i16(
+    iirdsp_filter_t* f,
+    const int16_t* x,
+    int16_t* y,
+    iirdsp_real in_scale,
+    iirdsp_real out_scale,
+    int N
+);
+
 /**
  * Zero-phase filtering via forward-backward filtering (filtfilt)
  *
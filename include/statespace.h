@@ -0,0 +1,148 @@
+/**
+ * @file statespace.h
+ * @brief Block state-space engine for a whole biquad cascade
+ */
+
+#ifndef IIRDSP_STATESPACE_H
+#define IIRDSP_STATESPACE_H
+
+#include "config.h"
+#include "sos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum state dimension (two DF2T states per section)
+ */
+#define IIRDSP_STATESPACE_MAX_STATES (2 * IIRDSP_MAX_SECTIONS)
+
+/**
+ * Maximum block length L (outputs per matrix step)
+ */
+#define IIRDSP_STATESPACE_MAX_BLOCK 32
+
+/**
+ * Cascade as one state-space system, evaluated L samples at a time
+ *
+ * The state vector is [z1_0, z2_0, z1_1, z2_1, ...], i.e. exactly the DF2T
+ * states of the source sections, so state can be moved between engines.
+ * Per-sample model:
+ *   s[n+1] = A s[n] + B x[n],   y[n] = C s[n] + D x[n]
+ * Block model for x_blk = x[k..k+L-1]:
+ *   s[k+L] = A^L s[k] + K x_blk,   y_blk = O s[k] + T x_blk
+ * with K = [A^(L-1)B ... AB B], O rows C A^j and T the lower-triangular
+ * Toeplitz matrix of impulse-response samples. Matrices are stored
+ * column-major and the state is zero-padded to a multiple of 8, so each
+ * block step is a fixed-size run of 8-wide multiply-adds.
+ */
+typedef struct {
+    int num_states;  /* 2 * num_sections, padded to a multiple of 8 */
+    int L;           /* Block length */
+
+    /* Per-sample model (for the tail of a buffer) */
+    iirdsp_real A[IIRDSP_STATESPACE_MAX_STATES][IIRDSP_STATESPACE_MAX_STATES];  /* A[col][row] */
+    iirdsp_real B[IIRDSP_STATESPACE_MAX_STATES];
+    iirdsp_real C[IIRDSP_STATESPACE_MAX_STATES];
+    iirdsp_real D;
+
+    /* Block model, column-major */
+    iirdsp_real AL[IIRDSP_STATESPACE_MAX_STATES][IIRDSP_STATESPACE_MAX_STATES];  /* A^L: [col][row] */
+    iirdsp_real K[IIRDSP_STATESPACE_MAX_BLOCK][IIRDSP_STATESPACE_MAX_STATES];    /* [input][state] */
+    iirdsp_real O[IIRDSP_STATESPACE_MAX_STATES][IIRDSP_STATESPACE_MAX_BLOCK];    /* [state][output] */
+    iirdsp_real T[IIRDSP_STATESPACE_MAX_BLOCK][IIRDSP_STATESPACE_MAX_BLOCK];     /* [input][output] */
+
+    iirdsp_real state[IIRDSP_STATESPACE_MAX_STATES];
+} iirdsp_statespace_t;
+
+/**
+ * Build the block state-space form of a designed filter
+ *
+ * Matrices are computed in double precision. State is zeroed.
+ *
+ * @param ss Engine to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param L Block length (a multiple of 8 up to IIRDSP_STATESPACE_MAX_BLOCK),
+ *          or 0 to choose automatically (see iirdsp_statespace_auto_block)
+ * @return 0 on success, -1 for an invalid block length
+ */
+int iirdsp_statespace_init(iirdsp_statespace_t* ss, const iirdsp_filter_t* f, int L);
+
+/**
+ * Block length minimizing multiply-adds per output for a filter
+ *
+ * Per block the engine does about n^2 + 2nL + L^2/2 multiply-adds for
+ * n (padded) states, which per output is smallest near L = n..1.4n.
+ * Returns n, the smallest multiple of 8 in that range.
+ *
+ * @param f Designed filter
+ * @return Block length
+ */
+int iirdsp_statespace_auto_block(const iirdsp_filter_t* f);
+
+/**
+ * Reset state (zero the state vector)
+ *
+ * @param ss Engine
+ */
+void iirdsp_statespace_reset(iirdsp_statespace_t* ss);
+
+/**
+ * Copy the DF2T states of a filter into the engine
+ *
+ * @param ss Engine
+ * @param f Filter with the same sections the engine was built from
+ */
+void iirdsp_statespace_load_state(iirdsp_statespace_t* ss, const iirdsp_filter_t* f);
+
+/**
+ * Copy the engine state back into the DF2T states of a filter
+ *
+ * @param ss Engine
+ * @param f Filter with the same sections the engine was built from
+ */
+void iirdsp_statespace_store_state(const iirdsp_statespace_t* ss, iirdsp_filter_t* f);
+
+/**
+ * Process a buffer of samples
+ *
+ * Produces the same output as iirdsp_process_buffer on the source filter,
+ * up to rounding. x and y may alias.
+ *
+ * @param ss Engine
+ * @param x Input signal (length N)
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_statespace_process_buffer(
+    iirdsp_statespace_t* ss,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+);
+
+/**
+ * Measure the accuracy of the engine against the DF2T cascade
+ *
+ * Runs an impulse followed by a deterministic pseudo-random sequence
+ * through both from zero state and returns the largest absolute output
+ * difference. The engine's state is restored afterwards; f is not
+ * modified.
+ *
+ * @param ss Engine
+ * @param f Source filter
+ * @param N Number of test samples
+ * @return Maximum absolute error
+ */
+iirdsp_real iirdsp_statespace_max_error(
+    iirdsp_statespace_t* ss,
+    const iirdsp_filter_t* f,
+    int N
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_STATESPACE_H */
@@ -0,0 +1,126 @@
+/**
+ * @file tunable.h
+ * @brief Butterworth filter with a run-time adjustable cutoff
+ */
+
+#ifndef IIRDSP_TUNABLE_H
+#define IIRDSP_TUNABLE_H
+
+#include "config.h"
+#include "sos.h"
+#include "butter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum number of cutoff frequencies in the coefficient table
+ */
+#define IIRDSP_TUNABLE_MAX_POINTS 32
+
+/**
+ * Samples between coefficient updates in iirdsp_tunable_process_ramp
+ */
+#define IIRDSP_TUNABLE_RAMP_BLOCK 16
+
+/**
+ * Butterworth filter with a precomputed coefficient table
+ *
+ * The design is evaluated once at num_points cutoffs spaced evenly in
+ * log-frequency. Each section of each entry is normalized to unit gain
+ * at DC (low-pass) or Nyquist (high-pass), so every coefficient varies
+ * smoothly with the cutoff. Retuning interpolates linearly between the
+ * two neighbouring entries, weighted by the prewarped cutoff
+ * tan(pi * fc / fs) that the bilinear design scales its poles by, and
+ * writes the sections of filter in place, keeping z1/z2. With entries
+ * 10-20% apart the magnitude response stays within about 1% of the
+ * exact design. A straight line between two stable sections stays inside
+ * the stability triangle |a2| < 1, |a1| < 1 + a2, so any interpolated
+ * filter is stable.
+ *
+ * filter is an ordinary cascade: iirdsp_process_sample and friends can
+ * be used on it directly.
+ */
+typedef struct {
+    iirdsp_filter_t filter;     /* Current coefficients and state */
+    int num_points;
+    iirdsp_real f_min_hz;
+    iirdsp_real f_max_hz;
+    iirdsp_real fs_hz;
+    iirdsp_real points_per_log; /* (num_points - 1) / log(f_max_hz / f_min_hz) */
+    iirdsp_real cutoff_hz;      /* Current cutoff */
+    iirdsp_real warped[IIRDSP_TUNABLE_MAX_POINTS];                         /* tan(pi * fc / fs) */
+    iirdsp_real table[IIRDSP_TUNABLE_MAX_POINTS][IIRDSP_MAX_SECTIONS][5];  /* b0 b1 b2 a1 a2 */
+} iirdsp_tunable_t;
+
+/**
+ * Build the coefficient table for a tunable low-pass or high-pass filter
+ *
+ * The cutoff starts at f_min_hz and state is zeroed.
+ *
+ * @param t Tunable filter to initialize
+ * @param type IIRDSP_LOWPASS or IIRDSP_HIGHPASS
+ * @param order Filter order (as for butter_lowpass_init)
+ * @param f_min_hz Lowest cutoff frequency (Hz)
+ * @param f_max_hz Highest cutoff frequency (Hz), below fs_hz / 2
+ * @param fs_hz Sampling frequency (Hz)
+ * @param num_points Table size (2..IIRDSP_TUNABLE_MAX_POINTS)
+ * @return 0 on success, -1 for an invalid order, -2 for an invalid
+ *         frequency range, -3 for an invalid type or table size
+ */
+int iirdsp_tunable_init(
+    iirdsp_tunable_t* t,
+    iirdsp_btype_t type,
+    int order,
+    iirdsp_real f_min_hz,
+    iirdsp_real f_max_hz,
+    iirdsp_real fs_hz,
+    int num_points
+);
+
+/**
+ * Retune to a new cutoff, keeping the filter state
+ *
+ * Cutoffs outside [f_min_hz, f_max_hz] are clamped.
+ *
+ * @param t Tunable filter
+ * @param cutoff_hz New cutoff frequency (Hz)
+ */
+void iirdsp_tunable_set_cutoff(iirdsp_tunable_t* t, iirdsp_real cutoff_hz);
+
+/**
+ * Current cutoff frequency
+ *
+ * @param t Tunable filter
+ * @return Cutoff (Hz)
+ */
+iirdsp_real iirdsp_tunable_get_cutoff(const iirdsp_tunable_t* t);
+
+/**
+ * Process a buffer while gliding the cutoff to a new value
+ *
+ * The cutoff moves evenly in log-frequency from its current value to
+ * cutoff_end_hz, with coefficients updated every IIRDSP_TUNABLE_RAMP_BLOCK
+ * samples, so large retunes do not produce a step in the output. The
+ * buffer ends at cutoff_end_hz. x and y may alias.
+ *
+ * @param t Tunable filter
+ * @param x Input signal (length N)
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ * @param cutoff_end_hz Cutoff at the end of the buffer (Hz, clamped)
+ */
+void iirdsp_tunable_process_ramp(
+    iirdsp_tunable_t* t,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N,
+    iirdsp_real cutoff_end_hz
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IIRDSP_TUNABLE_H */
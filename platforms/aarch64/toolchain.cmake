@@ -0,0 +1,28 @@
+# Cross toolchain for AArch64 Linux (Graviton, Cortex-A)
+#
+# Debian/Ubuntu packages: gcc-aarch64-linux-gnu g++-aarch64-linux-gnu qemu-user
+#
+#   cmake -S . -B build-aarch64 \
+#         -DCMAKE_TOOLCHAIN_FILE=platforms/aarch64/toolchain.cmake
+#   cmake --build build-aarch64
+#   ctest --test-dir build-aarch64     # runs under qemu-aarch64
+#
+# Add -DIIRDSP_ENABLE_SVE=ON to build the SVE kernel; the emulator runs
+# with "-cpu max", which implements SVE.
+
+set(CMAKE_SYSTEM_NAME Linux)
+set(CMAKE_SYSTEM_PROCESSOR aarch64)
+
+set(IIRDSP_AARCH64_PREFIX "aarch64-linux-gnu" CACHE STRING "Cross compiler prefix")
+set(IIRDSP_AARCH64_SYSROOT "/usr/${IIRDSP_AARCH64_PREFIX}" CACHE PATH "Target sysroot for qemu")
+
+set(CMAKE_C_COMPILER ${IIRDSP_AARCH64_PREFIX}-gcc)
+set(CMAKE_CXX_COMPILER ${IIRDSP_AARCH64_PREFIX}-g++)
+
+set(CMAKE_FIND_ROOT_PATH ${IIRDSP_AARCH64_SYSROOT})
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
+
+# ctest (and add_test COMMAND <target>) run target binaries through qemu
+set(CMAKE_CROSSCOMPILING_EMULATOR qemu-aarch64 -cpu max -L ${IIRDSP_AARCH64_SYSROOT})
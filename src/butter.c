@@ -2,18 +2,15 @@
  * @file butter.c
  * @brief Butterworth IIR filter design implementation
  *
- * All filters are designed using the classical digital IIR design pipeline:
- *   1. Analog Butterworth prototype (s-domain)
- *   2. Frequency transformation (for high-pass and band-pass)
- *   3. Bilinear transform with pre-warping
- *   4. Pole/zero pairing into second-order sections
- *   5. Gain normalization
- *   6. Direct Form II Transposed coefficients
+ * Only the analog Butterworth prototype is specific to this file; the
+ * frequency transformation, bilinear transform, pole/zero pairing and gain
+ * normalization are the shared pipeline in iir_design.c.
  *
  * This implementation produces coefficients that match scipy.signal.butter(..., output='sos')
  */
 
 #include "butter.h"
+#include "iir_design.h"
 #include <math.h>
 #include <string.h>
 
@@ -26,227 +23,149 @@
  * Compute Butterworth analog prototype poles
  *
  * For a Butterworth filter of order N, the poles in the s-plane are:
- *   p_k = e^(j * pi * (2*k + N + 1) / (2*N))
- *   for k = 0, 1, ..., N-1
+ *   p_m = -e^(j * pi * m / (2*N))
+ *   for m = -N+1, -N+3, ..., N-1
  *
- * We store only the left-half plane (stable) poles as (real, imag) pairs.
+ * All poles lie on the unit circle in the left-half plane. For odd N the
+ * middle pole is exactly -1. There are no finite zeros.
  *
  * @param order Filter order N
- * @param poles Output array of pole pairs (2*order real values: [re0, im0, re1, im1, ...])
+ * @param proto Output prototype
  */
-static void butter_analog_poles(int order, iirdsp_real* poles)
+static void butter_prototype(int order, iirdsp_prototype_t* proto)
 {
     for (int k = 0; k < order; k++) {
-        iirdsp_real angle = M_PI * (2.0 * k + order + 1.0) / (2.0 * order);
-        poles[2*k]     = -sin(angle);  /* Real part */
-        poles[2*k + 1] =  cos(angle);  /* Imaginary part */
+        int m = 2 * k - order + 1;
+        iirdsp_real angle = M_PI * m / (2.0 * order);
+        proto->poles[2*k]     = -cos(angle);  /* Real part */
+        proto->poles[2*k + 1] = -sin(angle);  /* Imaginary part */
     }
+    proto->num_poles = order;
+    proto->num_zeros = 0;
+    proto->dc_gain = 1.0;
 }
 
 /**
- * Apply bilinear transform to convert analog poles to digital filter
- *
- * Bilinear transform: s = 2*fs * (z-1)/(z+1)
- * 
- * For analog pole p_s and zero at infinity:
- *   H(s) = K / (s - p_s)
- *
- * After bilinear transform, the digital pole is:
- *   p_z = (1 + p_s/(2*fs)) / (1 - p_s/(2*fs))
- *
- * And the digital zero is at z = -1 for low-pass.
+ * Low-pass Butterworth filter initialization
  *
- * @param poles_s Analog poles (complex pairs: re, im)
- * @param zeros_s Analog zeros (complex pairs: re, im), NULL for all-pole filter
- * @param num_poles Number of poles
- * @param num_zeros Number of zeros (0 for low-pass from infinity)
- * @param fs_hz Sampling frequency
- * @param filter_type 0=lowpass, 1=highpass, 2=bandpass
- * @param f Filter structure to populate
+ * @param c Cascade to initialize
+ * @param order Filter order
+ * @param cutoff_hz Cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
  */
-static void bilinear_zpk(
-    const iirdsp_real* poles_s,
-    const iirdsp_real* zeros_s,
-    int num_poles,
-    int num_zeros,
-    iirdsp_real fs_hz,
-    int filter_type,
-    iirdsp_filter_t* f
+int butter_lowpass_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
 )
 {
-    iirdsp_real fs2 = 2.0 * fs_hz;
-    int num_sections = (num_poles + 1) / 2;
-    f->num_sections = num_sections;
+    iirdsp_prototype_t proto;
 
-    /* Convert analog poles to digital */
-    iirdsp_real poles_z[2 * IIRDSP_MAX_SECTIONS * 2];
-    for (int i = 0; i < num_poles; i++) {
-        iirdsp_real p_re = poles_s[2*i];
-        iirdsp_real p_im = poles_s[2*i + 1];
-        
-        /* p_z = (1 + p_s/fs2) / (1 - p_s/fs2) */
-        iirdsp_real num_re = 1.0 + p_re / fs2;
-        iirdsp_real num_im = p_im / fs2;
-        iirdsp_real den_re = 1.0 - p_re / fs2;
-        iirdsp_real den_im = -p_im / fs2;
-        
-        /* Complex division */
-        iirdsp_real denom = den_re * den_re + den_im * den_im;
-        poles_z[2*i]     = (num_re * den_re + num_im * den_im) / denom;
-        poles_z[2*i + 1] = (num_im * den_re - num_re * den_im) / denom;
-    }
-
-    /* Convert analog zeros to digital (or use -1 for low-pass, +1 for high-pass) */
-    iirdsp_real zeros_z[2 * IIRDSP_MAX_SECTIONS * 2];
-    int actual_num_zeros = num_poles;  /* Digital filter has same number of zeros as poles */
-    
-    if (filter_type == 0) {  /* Low-pass: zeros at z = -1 */
-        for (int i = 0; i < actual_num_zeros; i++) {
-            zeros_z[2*i]     = -1.0;
-            zeros_z[2*i + 1] =  0.0;
-        }
-    } else if (filter_type == 1) {  /* High-pass: zeros at z = +1 */
-        for (int i = 0; i < actual_num_zeros; i++) {
-            zeros_z[2*i]     =  1.0;
-            zeros_z[2*i + 1] =  0.0;
-        }
-    } else {  /* Band-pass: zeros at z = -1 and z = +1 */
-        for (int i = 0; i < actual_num_zeros / 2; i++) {
-            zeros_z[2*i]     = -1.0;
-            zeros_z[2*i + 1] =  0.0;
-        }
-        for (int i = actual_num_zeros / 2; i < actual_num_zeros; i++) {
-            zeros_z[2*i]     =  1.0;
-            zeros_z[2*i + 1] =  0.0;
-        }
+    if (order <= 0 || order > IIRDSP_DESIGN_MAX_ORDER) {
+        return -1;  /* Invalid order */
     }
+    butter_prototype(order, &proto);
+    return iirdsp_design_analog(c, &proto, IIRDSP_LOWPASS, cutoff_hz, 0.0, fs_hz);
+}
 
-    /* Pair poles and zeros into second-order sections */
-    for (int i = 0; i < num_sections; i++) {
-        iirdsp_real p1_re, p1_im, p2_re, p2_im;
-        iirdsp_real z1_re, z1_im, z2_re, z2_im;
-        
-        /* Get pole pair (or single pole for odd order) */
-        if (2*i + 1 < num_poles) {
-            /* Conjugate pair */
-            p1_re = poles_z[4*i];
-            p1_im = poles_z[4*i + 1];
-            p2_re = poles_z[4*i + 2];
-            p2_im = poles_z[4*i + 3];
-        } else if (2*i < num_poles) {
-            /* Single real pole (odd order, last section) */
-            p1_re = poles_z[2*(num_poles - 1)];
-            p1_im = poles_z[2*(num_poles - 1) + 1];
-            p2_re = p1_re;
-            p2_im = -p1_im;  /* Conjugate for completeness */
-        } else {
-            /* Should not happen */
-            p1_re = 0.0;
-            p1_im = 0.0;
-            p2_re = 0.0;
-            p2_im = 0.0;
-        }
-
-        /* Get zero pair */
-        if (2*i + 1 < actual_num_zeros) {
-            z1_re = zeros_z[4*i];
-            z1_im = zeros_z[4*i + 1];
-            z2_re = zeros_z[4*i + 2];
-            z2_im = zeros_z[4*i + 3];
-        } else if (2*i < actual_num_zeros) {
-            z1_re = zeros_z[2*(actual_num_zeros - 1)];
-            z1_im = zeros_z[2*(actual_num_zeros - 1) + 1];
-            z2_re = z1_re;
-            z2_im = z1_im;
-        } else {
-            z1_re = zeros_z[0];
-            z1_im = zeros_z[1];
-            z2_re = zeros_z[0];
-            z2_im = zeros_z[1];
-        }
-
-        /* Form second-order section coefficients */
-        /* Numerator: (z - z1)(z - z2) = z^2 - (z1+z2)*z + z1*z2 */
-        iirdsp_real b0 = 1.0;
-        iirdsp_real b1 = -(z1_re + z2_re);
-        iirdsp_real b2 = z1_re * z2_re - z1_im * z2_im;
-
-        /* Denominator: (z - p1)(z - p2) = z^2 - (p1+p2)*z + p1*p2 */
-        iirdsp_real a0 = 1.0;
-        iirdsp_real a1 = -(p1_re + p2_re);
-        iirdsp_real a2 = p1_re * p2_re - p1_im * p2_im;
+/**
+ * High-pass Butterworth filter initialization
+ *
+ * High-pass is obtained by transforming the low-pass prototype:
+ *   s_lp → wc / s_hp
+ *
+ * @param c Cascade to initialize
+ * @param order Filter order
+ * @param cutoff_hz Cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int butter_highpass_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_prototype_t proto;
 
-        /* Normalize by a0 and store */
-        f->sections[i].b0 = b0 / a0;
-        f->sections[i].b1 = b1 / a0;
-        f->sections[i].b2 = b2 / a0;
-        f->sections[i].a1 = a1 / a0;
-        f->sections[i].a2 = a2 / a0;
-        f->sections[i].z1 = 0.0;
-        f->sections[i].z2 = 0.0;
+    if (order <= 0 || order > IIRDSP_DESIGN_MAX_ORDER) {
+        return -1;  /* Invalid order */
     }
+    butter_prototype(order, &proto);
+    return iirdsp_design_analog(c, &proto, IIRDSP_HIGHPASS, cutoff_hz, 0.0, fs_hz);
 }
 
 /**
- * Compute gain at a specific frequency for normalization
+ * Band-pass Butterworth filter initialization
+ *
+ * Band-pass is obtained by transforming the low-pass prototype:
+ *   s_lp → (s^2 + w0^2) / (s * BW)
+ *   where w0 = sqrt(wc1 * wc2), BW = wc2 - wc1
+ *
+ * This transformation produces 2*order poles (doubles the filter order).
  *
- * @param f Filter to evaluate
- * @param freq Frequency (normalized: 0=DC, 0.5=Nyquist)
- * @return Magnitude response at freq
+ * @param c Cascade to initialize
+ * @param order Filter order (band-pass will produce 2*order poles)
+ * @param f_low_hz Low cutoff frequency (Hz)
+ * @param f_high_hz High cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
  */
-static iirdsp_real compute_gain_at_freq(const iirdsp_filter_t* f, iirdsp_real freq)
+int butter_bandpass_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+)
 {
-    iirdsp_real w = 2.0 * M_PI * freq;
-    iirdsp_real cos_w = cos(w);
-    iirdsp_real sin_w = sin(w);
-    iirdsp_real cos_2w = cos(2.0 * w);
-    iirdsp_real sin_2w = sin(2.0 * w);
-    
-    iirdsp_real gain_re = 1.0;
-    iirdsp_real gain_im = 0.0;
-    
-    for (int i = 0; i < f->num_sections; i++) {
-        /* Evaluate H(e^jw) for this section */
-        iirdsp_real num_re = f->sections[i].b0 + f->sections[i].b1 * cos_w + f->sections[i].b2 * cos_2w;
-        iirdsp_real num_im = -f->sections[i].b1 * sin_w - f->sections[i].b2 * sin_2w;
-        iirdsp_real den_re = 1.0 + f->sections[i].a1 * cos_w + f->sections[i].a2 * cos_2w;
-        iirdsp_real den_im = -f->sections[i].a1 * sin_w - f->sections[i].a2 * sin_2w;
-        
-        /* Complex division: H = num / den */
-        iirdsp_real denom = den_re * den_re + den_im * den_im;
-        iirdsp_real h_re = (num_re * den_re + num_im * den_im) / denom;
-        iirdsp_real h_im = (num_im * den_re - num_re * den_im) / denom;
-        
-        /* Accumulate gain */
-        iirdsp_real new_gain_re = gain_re * h_re - gain_im * h_im;
-        iirdsp_real new_gain_im = gain_re * h_im + gain_im * h_re;
-        gain_re = new_gain_re;
-        gain_im = new_gain_im;
+    iirdsp_prototype_t proto;
+
+    if (order <= 0 || order > IIRDSP_DESIGN_MAX_SECTIONS) {
+        return -1;  /* Invalid order (band-pass doubles it) */
     }
-    
-    return sqrt(gain_re * gain_re + gain_im * gain_im);
+    butter_prototype(order, &proto);
+    return iirdsp_design_analog(c, &proto, IIRDSP_BANDPASS, f_low_hz, f_high_hz, fs_hz);
 }
 
 /**
- * Normalize filter gain at specified frequency
+ * Band-stop Butterworth filter initialization
+ *
+ * Band-stop is obtained by transforming the low-pass prototype:
+ *   s_lp → (s * BW) / (s^2 + w0^2)
+ *   where w0 = sqrt(wc1 * wc2), BW = wc2 - wc1
  *
- * @param f Filter to normalize
- * @param freq Frequency (normalized: 0=DC, 0.5=Nyquist)
+ * This transformation produces 2*order poles, and 2*order zeros at +/-j*w0.
+ *
+ * @param c Cascade to initialize
+ * @param order Filter order (band-stop will produce 2*order poles)
+ * @param f_low_hz Low cutoff frequency (Hz)
+ * @param f_high_hz High cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
  */
-static void normalize_gain(iirdsp_filter_t* f, iirdsp_real freq)
+int butter_bandstop_init_cascade(
+    iirdsp_cascade_t* c,
+    int order,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+)
 {
-    iirdsp_real gain = compute_gain_at_freq(f, freq);
-    
-    if (gain > 1e-10) {
-        /* Normalize first section's numerator */
-        f->sections[0].b0 /= gain;
-        f->sections[0].b1 /= gain;
-        f->sections[0].b2 /= gain;
+    iirdsp_prototype_t proto;
+
+    if (order <= 0 || order > IIRDSP_DESIGN_MAX_SECTIONS) {
+        return -1;  /* Invalid order (band-stop doubles it) */
     }
+    butter_prototype(order, &proto);
+    return iirdsp_design_analog(c, &proto, IIRDSP_BANDSTOP, f_low_hz, f_high_hz, fs_hz);
 }
 
 /**
- * Low-pass Butterworth filter initialization
+ * Low-pass Butterworth filter initialization (fixed-size filter)
  *
  * @param f Filter structure to initialize
  * @param order Filter order
@@ -261,40 +180,18 @@ int butter_lowpass_init(
     iirdsp_real fs_hz
 )
 {
-    if (order <= 0 || order > 2 * IIRDSP_MAX_SECTIONS) {
-        return -1;  /* Invalid order */
-    }
-    if (cutoff_hz <= 0.0 || cutoff_hz >= fs_hz / 2.0) {
-        return -2;  /* Invalid cutoff frequency */
-    }
-
-    /* Compute analog Butterworth prototype poles */
-    iirdsp_real poles_s[2 * IIRDSP_MAX_SECTIONS * 2];
-    butter_analog_poles(order, poles_s);
+    iirdsp_cascade_t c;
+    iirdsp_cascade_init(&c, f->sections, IIRDSP_MAX_SECTIONS);
 
-    /* Pre-warp the cutoff frequency */
-    iirdsp_real wc_warped = 2.0 * fs_hz * tan(M_PI * cutoff_hz / fs_hz);
-    
-    /* Scale analog poles by warped cutoff */
-    for (int i = 0; i < order; i++) {
-        poles_s[2*i]     *= wc_warped;
-        poles_s[2*i + 1] *= wc_warped;
+    int ret = butter_lowpass_init_cascade(&c, order, cutoff_hz, fs_hz);
+    if (ret == 0) {
+        f->num_sections = c.num_sections;
     }
-
-    /* Apply bilinear transform */
-    bilinear_zpk(poles_s, NULL, order, 0, fs_hz, 0, f);
-
-    /* Normalize gain at DC */
-    normalize_gain(f, 0.0);
-
-    return 0;
+    return ret;
 }
 
 /**
- * High-pass Butterworth filter initialization
- *
- * High-pass is obtained by transforming the low-pass prototype:
- *   s_lp → wc / s_hp
+ * High-pass Butterworth filter initialization (fixed-size filter)
  *
  * @param f Filter structure to initialize
  * @param order Filter order
@@ -309,48 +206,18 @@ int butter_highpass_init(
     iirdsp_real fs_hz
 )
 {
-    if (order <= 0 || order > 2 * IIRDSP_MAX_SECTIONS) {
-        return -1;  /* Invalid order */
-    }
-    if (cutoff_hz <= 0.0 || cutoff_hz >= fs_hz / 2.0) {
-        return -2;  /* Invalid cutoff frequency */
-    }
-
-    /* Compute analog Butterworth prototype poles */
-    iirdsp_real poles_s[2 * IIRDSP_MAX_SECTIONS * 2];
-    butter_analog_poles(order, poles_s);
+    iirdsp_cascade_t c;
+    iirdsp_cascade_init(&c, f->sections, IIRDSP_MAX_SECTIONS);
 
-    /* Pre-warp the cutoff frequency */
-    iirdsp_real wc_warped = 2.0 * fs_hz * tan(M_PI * cutoff_hz / fs_hz);
-
-    /* Low-pass to high-pass transformation: s → wc/s */
-    for (int i = 0; i < order; i++) {
-        iirdsp_real p_re = poles_s[2*i];
-        iirdsp_real p_im = poles_s[2*i + 1];
-        iirdsp_real mag_sq = p_re * p_re + p_im * p_im;
-        
-        /* Invert and scale */
-        poles_s[2*i]     = -p_re * wc_warped / mag_sq;
-        poles_s[2*i + 1] = -p_im * wc_warped / mag_sq;
+    int ret = butter_highpass_init_cascade(&c, order, cutoff_hz, fs_hz);
+    if (ret == 0) {
+        f->num_sections = c.num_sections;
     }
-
-    /* Apply bilinear transform (filter_type=1 for highpass) */
-    bilinear_zpk(poles_s, NULL, order, 0, fs_hz, 1, f);
-
-    /* Normalize gain at Nyquist */
-    normalize_gain(f, 0.5);
-
-    return 0;
+    return ret;
 }
 
 /**
- * Band-pass Butterworth filter initialization
- *
- * Band-pass is obtained by transforming the low-pass prototype:
- *   s_lp → (s^2 + w0^2) / (s * BW)
- *   where w0 = sqrt(wc1 * wc2), BW = wc2 - wc1
- *
- * This transformation produces 2*order poles (doubles the filter order).
+ * Band-pass Butterworth filter initialization (fixed-size filter)
  *
  * @param f Filter structure to initialize
  * @param order Filter order (band-pass will produce 2*order poles)
@@ -367,64 +234,168 @@ int butter_bandpass_init(
     iirdsp_real fs_hz
 )
 {
-    if (order <= 0 || order > IIRDSP_MAX_SECTIONS) {
-        return -1;  /* Invalid order (band-pass doubles it) */
+    iirdsp_cascade_t c;
+    iirdsp_cascade_init(&c, f->sections, IIRDSP_MAX_SECTIONS);
+
+    int ret = butter_bandpass_init_cascade(&c, order, f_low_hz, f_high_hz, fs_hz);
+    if (ret == 0) {
+        f->num_sections = c.num_sections;
     }
-    if (f_low_hz <= 0.0 || f_high_hz <= f_low_hz || f_high_hz >= fs_hz / 2.0) {
-        return -2;  /* Invalid frequency range */
+    return ret;
+}
+
+/**
+ * Band-stop Butterworth filter initialization (fixed-size filter)
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (band-stop will produce 2*order poles)
+ * @param f_low_hz Low cutoff frequency (Hz)
+ * @param f_high_hz High cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int butter_bandstop_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_cascade_t c;
+    iirdsp_cascade_init(&c, f->sections, IIRDSP_MAX_SECTIONS);
+
+    int ret = butter_bandstop_init_cascade(&c, order, f_low_hz, f_high_hz, fs_hz);
+    if (ret == 0) {
+        f->num_sections = c.num_sections;
     }
+    return ret;
+}
 
-    /* Compute analog Butterworth prototype poles */
-    iirdsp_real poles_lp[2 * IIRDSP_MAX_SECTIONS];
-    butter_analog_poles(order, poles_lp);
+/**
+ * Minimum Butterworth order for a passband/stopband specification
+ *
+ * Works on the prewarped (analog) edges W = tan(pi * f / fs), where the
+ * digital response equals the analog one. The stopband edge is first
+ * mapped to the equivalent low-pass prototype frequency nat (passband
+ * edge at 1); then
+ *   order = ceil(log10((10^(gstop/10) - 1) / (10^(gpass/10) - 1)) / (2 log10(nat)))
+ * and the -3 dB frequency is placed so the passband edge loses exactly
+ * gpass_db: edge_scale = (10^(gpass/10) - 1)^(-1 / (2 order)).
+ *
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS or IIRDSP_BANDPASS
+ * @param wp_hz Passband edge (Hz); band-pass: {low, high}
+ * @param ws_hz Stopband edge (Hz); band-pass: {low, high}
+ * @param gpass_db Maximum passband loss (dB)
+ * @param gstop_db Minimum stopband attenuation (dB)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param wn_hz Output cutoff for the designer (Hz), may be NULL
+ * @return Order (>= 1), or negative error code
+ */
+int butter_order(
+    iirdsp_btype_t type,
+    const iirdsp_real* wp_hz,
+    const iirdsp_real* ws_hz,
+    iirdsp_real gpass_db,
+    iirdsp_real gstop_db,
+    iirdsp_real fs_hz,
+    iirdsp_real* wn_hz
+)
+{
+    const int num_edges = (type == IIRDSP_BANDPASS) ? 2 : 1;
+    double passb[2], stopb[2], nat;
 
-    /* Pre-warp both cutoff frequencies */
-    iirdsp_real wc1 = 2.0 * fs_hz * tan(M_PI * f_low_hz / fs_hz);
-    iirdsp_real wc2 = 2.0 * fs_hz * tan(M_PI * f_high_hz / fs_hz);
-    iirdsp_real w0 = sqrt(wc1 * wc2);  /* Center frequency */
-    iirdsp_real bw = wc2 - wc1;         /* Bandwidth */
+    if (type != IIRDSP_LOWPASS && type != IIRDSP_HIGHPASS && type != IIRDSP_BANDPASS) {
+        return -3;  /* Invalid type */
+    }
+    if (!(gpass_db > 0.0) || !(gstop_db > gpass_db)) {
+        return -3;  /* Invalid gains */
+    }
+    for (int i = 0; i < num_edges; i++) {
+        if (!(wp_hz[i] > 0.0 && wp_hz[i] < fs_hz / 2.0 &&
+              ws_hz[i] > 0.0 && ws_hz[i] < fs_hz / 2.0)) {
+            return -2;  /* Edge outside (0, fs/2) */
+        }
+        passb[i] = tan(M_PI * wp_hz[i] / fs_hz);
+        stopb[i] = tan(M_PI * ws_hz[i] / fs_hz);
+    }
 
-    /* Low-pass to band-pass transformation */
-    /* Each pole p becomes two poles via: s^2 - p*BW*s + w0^2 = 0 */
-    iirdsp_real poles_bp[2 * IIRDSP_MAX_SECTIONS * 4];
-    int bp_count = 0;
+    if (type == IIRDSP_LOWPASS) {
+        if (!(ws_hz[0] > wp_hz[0])) {
+            return -2;
+        }
+        nat = stopb[0] / passb[0];
+    } else if (type == IIRDSP_HIGHPASS) {
+        if (!(ws_hz[0] < wp_hz[0])) {
+            return -2;
+        }
+        nat = passb[0] / stopb[0];
+    } else {
+        if (!(ws_hz[0] < wp_hz[0] && wp_hz[0] < wp_hz[1] && wp_hz[1] < ws_hz[1])) {
+            return -2;
+        }
+        /* Low-pass prototype frequency of each stopband edge; the nearer one rules */
+        nat = HUGE_VAL;
+        for (int i = 0; i < 2; i++) {
+            double w = (stopb[i] * stopb[i] - passb[0] * passb[1]) /
+                       (stopb[i] * (passb[1] - passb[0]));
+            nat = fmin(nat, fabs(w));
+        }
+    }
 
-    for (int i = 0; i < order; i++) {
-        iirdsp_real p_re = poles_lp[2*i];
-        iirdsp_real p_im = poles_lp[2*i + 1];
-        
-        /* Only use real part for LP->BP transform (imaginary handled separately) */
-        /* Solve: s^2 - p*BW*s + w0^2 = 0 */
-        iirdsp_real alpha = -p_re * bw / 2.0;
-        iirdsp_real beta_sq = alpha * alpha - w0 * w0;
-        
-        if (beta_sq >= 0.0) {
-            /* Real roots */
-            iirdsp_real beta = sqrt(beta_sq);
-            poles_bp[2*bp_count]     = alpha + beta;
-            poles_bp[2*bp_count + 1] = p_im * bw;
-            bp_count++;
-            poles_bp[2*bp_count]     = alpha - beta;
-            poles_bp[2*bp_count + 1] = p_im * bw;
-            bp_count++;
+    const double g_stop = pow(10.0, 0.1 * gstop_db) - 1.0;
+    const double g_pass = pow(10.0, 0.1 * gpass_db) - 1.0;
+    const int order = (int)ceil(log10(g_stop / g_pass) / (2.0 * log10(nat)));
+    const double edge_scale = pow(g_pass, -1.0 / (2.0 * order));
+
+    if (wn_hz) {
+        if (type == IIRDSP_LOWPASS) {
+            wn_hz[0] = atan(edge_scale * passb[0]) * fs_hz / M_PI;
+        } else if (type == IIRDSP_HIGHPASS) {
+            wn_hz[0] = atan(passb[0] / edge_scale) * fs_hz / M_PI;
         } else {
-            /* Complex roots */
-            iirdsp_real beta = sqrt(-beta_sq);
-            poles_bp[2*bp_count]     = alpha;
-            poles_bp[2*bp_count + 1] = beta + p_im * bw;
-            bp_count++;
-            poles_bp[2*bp_count]     = alpha;
-            poles_bp[2*bp_count + 1] = -beta + p_im * bw;
-            bp_count++;
+            /* Same geometric centre as the passband, bandwidth scaled */
+            const double half = edge_scale * (passb[1] - passb[0]) / 2.0;
+            const double root = sqrt(half * half + passb[0] * passb[1]);
+            wn_hz[0] = atan(root - half) * fs_hz / M_PI;
+            wn_hz[1] = atan(root + half) * fs_hz / M_PI;
         }
     }
+    return order;
+}
 
-    /* Apply bilinear transform (filter_type=2 for bandpass) */
-    bilinear_zpk(poles_bp, NULL, bp_count, 0, fs_hz, 2, f);
-
-    /* Normalize gain at center frequency */
-    iirdsp_real f_center = sqrt(f_low_hz * f_high_hz);
-    normalize_gain(f, f_center / fs_hz);
+/**
+ * Design the minimum-order Butterworth filter meeting a specification
+ *
+ * @param f Filter structure to initialize
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS or IIRDSP_BANDPASS
+ * @param wp_hz Passband edge (Hz); band-pass: {low, high}
+ * @param ws_hz Stopband edge (Hz); band-pass: {low, high}
+ * @param gpass_db Maximum passband loss (dB)
+ * @param gstop_db Minimum stopband attenuation (dB)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int butter_init_from_spec(
+    iirdsp_filter_t* f,
+    iirdsp_btype_t type,
+    const iirdsp_real* wp_hz,
+    const iirdsp_real* ws_hz,
+    iirdsp_real gpass_db,
+    iirdsp_real gstop_db,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_real wn[2];
+    int order = butter_order(type, wp_hz, ws_hz, gpass_db, gstop_db, fs_hz, wn);
 
-    return 0;
-}
\ No newline at end of file
+    if (order < 0) {
+        return order;
+    }
+    if (type == IIRDSP_LOWPASS) {
+        return butter_lowpass_init(f, order, wn[0], fs_hz);
+    } else if (type == IIRDSP_HIGHPASS) {
+        return butter_highpass_init(f, order, wn[0], fs_hz);
+    }
+    return butter_bandpass_init(f, order, wn[0], wn[1], fs_hz);
+}
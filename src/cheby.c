@@ -0,0 +1,248 @@
+/**
+ * @file cheby.c
+ * @brief Chebyshev type I and type II IIR filter design implementation
+ *
+ * Only the analog prototypes are specific to this file; the rest of the
+ * design is the shared pipeline in iir_design.c.
+ *
+ * This implementation produces coefficients that match
+ * scipy.signal.cheby1/cheby2(..., output='sos')
+ */
+
+#include "cheby.h"
+#include "iir_design.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Chebyshev type I analog prototype (scipy.signal.cheb1ap)
+ *
+ * With eps = sqrt(10^(rp/10) - 1) and mu = asinh(1/eps) / N, the poles lie
+ * on an ellipse:
+ *   p_m = -sinh(mu + j * pi * m / (2*N))   for m = -N+1, -N+3, ..., N-1
+ * The response is -rp dB at 1 rad/s; at DC it is 1 for odd N and
+ * 1/sqrt(1 + eps^2) for even N.
+ *
+ * @param order Filter order N
+ * @param rp_db Passband ripple (dB)
+ * @param proto Output prototype
+ */
+static void cheby1_prototype(int order, double rp_db, iirdsp_prototype_t* proto)
+{
+    const double eps_sq = pow(10.0, 0.1 * rp_db) - 1.0;
+    const double mu = asinh(1.0 / sqrt(eps_sq)) / order;
+
+    for (int k = 0; k < order; k++) {
+        int m = 2 * k - order + 1;
+        double theta = M_PI * m / (2.0 * order);
+        proto->poles[2*k]     = -sinh(mu) * cos(theta);  /* Real part */
+        proto->poles[2*k + 1] = -cosh(mu) * sin(theta);  /* Imaginary part */
+    }
+    proto->num_poles = order;
+    proto->num_zeros = 0;
+    proto->dc_gain = (order % 2) ? 1.0 : 1.0 / sqrt(1.0 + eps_sq);
+}
+
+/**
+ * Chebyshev type II analog prototype (scipy.signal.cheb2ap)
+ *
+ * The type I poles for ripple 1/de, de = 1/sqrt(10^(rs/10) - 1), are
+ * inverted so that the stopband starts at 1 rad/s, and zeros are placed on
+ * the imaginary axis:
+ *   z_m = j / sin(pi * m / (2*N))   (m = 0 skipped for odd N)
+ * DC gain is 1.
+ *
+ * @param order Filter order N
+ * @param rs_db Stopband attenuation (dB)
+ * @param proto Output prototype
+ */
+static void cheby2_prototype(int order, double rs_db, iirdsp_prototype_t* proto)
+{
+    const double de = 1.0 / sqrt(pow(10.0, 0.1 * rs_db) - 1.0);
+    const double mu = asinh(1.0 / de) / order;
+    int num_zeros = 0;
+
+    for (int k = 0; k < order; k++) {
+        int m = 2 * k - order + 1;
+        double theta = M_PI * m / (2.0 * order);
+        double p_re = -sinh(mu) * cos(theta);
+        double p_im = -cosh(mu) * sin(theta);
+        double mag_sq = p_re * p_re + p_im * p_im;
+
+        proto->poles[2*k]     =  p_re / mag_sq;  /* 1 / p */
+        proto->poles[2*k + 1] = -p_im / mag_sq;
+
+        if (m != 0) {
+            proto->zeros[2*num_zeros]     = 0.0;
+            proto->zeros[2*num_zeros + 1] = 1.0 / sin(theta);
+            num_zeros++;
+        }
+    }
+    proto->num_poles = order;
+    proto->num_zeros = num_zeros;
+    proto->dc_gain = 1.0;
+}
+
+/**
+ * Validate, build the prototype for the chosen type and design
+ */
+static int cheby_design(
+    iirdsp_filter_t* f,
+    int kind,
+    int order,
+    iirdsp_real ripple_db,
+    iirdsp_btype_t type,
+    iirdsp_real f1_hz,
+    iirdsp_real f2_hz,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_prototype_t proto;
+
+    if (order <= 0 || order > IIRDSP_DESIGN_MAX_ORDER) {
+        return -1;  /* Invalid order */
+    }
+    if (!(ripple_db > 0.0)) {
+        return -3;  /* Invalid ripple / attenuation */
+    }
+    if (kind == 1) {
+        cheby1_prototype(order, ripple_db, &proto);
+    } else {
+        cheby2_prototype(order, ripple_db, &proto);
+    }
+    return iirdsp_design_analog_filter(f, &proto, type, f1_hz, f2_hz, fs_hz);
+}
+
+/**
+ * Chebyshev type I low-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order
+ * @param rp_db Passband ripple (dB)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby1_lowpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    return cheby_design(f, 1, order, rp_db, IIRDSP_LOWPASS, cutoff_hz, 0.0, fs_hz);
+}
+
+/**
+ * Chebyshev type I high-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order
+ * @param rp_db Passband ripple (dB)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby1_highpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    return cheby_design(f, 1, order, rp_db, IIRDSP_HIGHPASS, cutoff_hz, 0.0, fs_hz);
+}
+
+/**
+ * Chebyshev type I band-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (band-pass will produce 2*order poles)
+ * @param rp_db Passband ripple (dB)
+ * @param f_low_hz Low passband edge (Hz)
+ * @param f_high_hz High passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby1_bandpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+)
+{
+    return cheby_design(f, 1, order, rp_db, IIRDSP_BANDPASS, f_low_hz, f_high_hz, fs_hz);
+}
+
+/**
+ * Chebyshev type II low-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order
+ * @param rs_db Stopband attenuation (dB)
+ * @param cutoff_hz Stopband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby2_lowpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    return cheby_design(f, 2, order, rs_db, IIRDSP_LOWPASS, cutoff_hz, 0.0, fs_hz);
+}
+
+/**
+ * Chebyshev type II high-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order
+ * @param rs_db Stopband attenuation (dB)
+ * @param cutoff_hz Stopband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby2_highpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    return cheby_design(f, 2, order, rs_db, IIRDSP_HIGHPASS, cutoff_hz, 0.0, fs_hz);
+}
+
+/**
+ * Chebyshev type II band-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (band-pass will produce 2*order poles)
+ * @param rs_db Stopband attenuation (dB)
+ * @param f_low_hz Low stopband edge (Hz)
+ * @param f_high_hz High stopband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int cheby2_bandpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rs_db,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+)
+{
+    return cheby_design(f, 2, order, rs_db, IIRDSP_BANDPASS, f_low_hz, f_high_hz, fs_hz);
+}
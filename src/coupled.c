@@ -0,0 +1,148 @@
+/**
+ * @file coupled.c
+ * @brief Float cascade with per-section structure implementation
+ *
+ * Coupled-form derivation: with states driven as
+ *   s1' = sigma s1 - omega s2 + x,  s2' = omega s1 + sigma s2
+ * the transfer functions are S1/X = (z - sigma) / D(z) and
+ * S2/X = omega / D(z), D(z) = z^2 - 2 sigma z + sigma^2 + omega^2, which
+ * is the section's denominator. Writing the section as
+ *   H = b0 + ((b1 - b0 a1) z + (b2 - b0 a2)) / D(z)
+ * and matching g1 S1 + g2 S2 to the remainder gives g1 and g2.
+ */
+
+#include "coupled.h"
+#include "response.h"
+#include "measure.h"
+#include <math.h>
+
+/**
+ * Build a float cascade from a designed filter, choosing each structure
+ *
+ * @param c Cascade to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param min_coupled_radius Smallest pole radius given the coupled form
+ * @return Number of coupled sections
+ */
+int iirdsp_coupled_init(iirdsp_coupled_t* c, const iirdsp_filter_t* f, double min_coupled_radius)
+{
+    int num_coupled = 0;
+
+    for (int i = 0; i < f->num_sections; i++) {
+        const iirdsp_biquad_t* s = &f->sections[i];
+        const double b0 = s->b0, b1 = s->b1, b2 = s->b2;
+        const double a1 = s->a1, a2 = s->a2;
+        const double omega_sq = a2 - 0.25 * a1 * a1;  /* > 0: complex poles */
+
+        if (omega_sq > 0.0 && iirdsp_section_pole_radius(s) >= min_coupled_radius) {
+            iirdsp_coupled_section_t* d = &c->coupled[i];
+            const double sigma = -0.5 * a1;
+            const double omega = sqrt(omega_sq);
+            const double g1 = b1 - b0 * a1;
+
+            d->b0 = (float)b0;
+            d->g1 = (float)g1;
+            d->g2 = (float)((b2 - b0 * a2 + g1 * sigma) / omega);
+            d->sigma = (float)sigma;
+            d->omega = (float)omega;
+            c->is_coupled[i] = 1;
+            num_coupled++;
+        } else {
+            iirdsp_biquad_f32_t* d = &c->df2t[i];
+            d->b0 = (float)b0;
+            d->b1 = (float)b1;
+            d->b2 = (float)b2;
+            d->a1 = (float)a1;
+            d->a2 = (float)a2;
+            c->is_coupled[i] = 0;
+        }
+    }
+    c->num_sections = f->num_sections;
+    c->num_coupled = num_coupled;
+    iirdsp_coupled_reset(c);
+
+    return num_coupled;
+}
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param c Cascade
+ */
+void iirdsp_coupled_reset(iirdsp_coupled_t* c)
+{
+    for (int i = 0; i < IIRDSP_MAX_SECTIONS; i++) {
+        c->df2t[i].z1 = 0.0f;
+        c->df2t[i].z2 = 0.0f;
+        c->coupled[i].s1 = 0.0f;
+        c->coupled[i].s2 = 0.0f;
+    }
+}
+
+/**
+ * Process a single float sample
+ *
+ * @param c Cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+float iirdsp_coupled_process_sample(iirdsp_coupled_t* c, float x)
+{
+    for (int i = 0; i < c->num_sections; i++) {
+        if (c->is_coupled[i]) {
+            iirdsp_coupled_section_t* s = &c->coupled[i];
+            const float s1 = s->s1, s2 = s->s2;
+            const float y = s->b0 * x + s->g1 * s1 + s->g2 * s2;
+            s->s1 = s->sigma * s1 - s->omega * s2 + x;
+            s->s2 = s->omega * s1 + s->sigma * s2;
+            x = y;
+        } else {
+            iirdsp_biquad_f32_t* s = &c->df2t[i];
+            const float y = s->b0 * x + s->z1;
+            s->z1 = s->b1 * x - s->a1 * y + s->z2;
+            s->z2 = s->b2 * x - s->a2 * y;
+            x = y;
+        }
+    }
+    return x;
+}
+
+/**
+ * Process a float buffer
+ *
+ * @param c Cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_coupled_process_buffer(iirdsp_coupled_t* c, const float* x, float* y, int N)
+{
+    for (int n = 0; n < N; n++) {
+        y[n] = iirdsp_coupled_process_sample(c, x[n]);
+    }
+}
+
+/* iirdsp_coupled_process_sample for the shared measurement */
+static float coupled_sample(void* ctx, float x)
+{
+    return iirdsp_coupled_process_sample((iirdsp_coupled_t*)ctx, x);
+}
+
+/**
+ * Measure the output error against the designed filter
+ *
+ * @param c Cascade
+ * @param f Designed filter c was built from
+ * @param num_samples Length of the test signal
+ * @return Relative RMS error
+ */
+double iirdsp_coupled_measure_error(iirdsp_coupled_t* c, const iirdsp_filter_t* f, int num_samples)
+{
+    double err;
+
+    iirdsp_coupled_reset(c);
+    err = iirdsp_measure_float_error(f, coupled_sample, c, num_samples);
+    iirdsp_coupled_reset(c);
+
+    return err;
+}
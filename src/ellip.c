@@ -0,0 +1,336 @@
+/**
+ * @file ellip.c
+ * @brief Elliptic (Cauer) IIR filter design implementation
+ *
+ * The analog prototype follows scipy.signal.ellipap; the elliptic
+ * integrals and Jacobi functions it needs are computed here with the
+ * arithmetic-geometric mean and Landen transformations (Cephes ellpk/ellpj
+ * style), so no special-function library is required. The rest of the
+ * design is the shared pipeline in iir_design.c.
+ *
+ * This implementation produces coefficients that match
+ * scipy.signal.ellip(..., output='sos')
+ */
+
+#include "ellip.h"
+#include "iir_design.h"
+#include <math.h>
+#include <float.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Iteration bound for the AGM / Landen sequences (converge in < 10) */
+#define ELLIP_MAX_ITER 16
+
+/* Terms of the nome series in ellipdeg */
+#define ELLIPDEG_TERMS 7
+
+/**
+ * Arithmetic-geometric mean of a and b
+ */
+static double agm(double a, double b)
+{
+    for (int i = 0; i < ELLIP_MAX_ITER && fabs(a - b) > DBL_EPSILON * a; i++) {
+        double t = 0.5 * (a + b);
+        b = sqrt(a * b);
+        a = t;
+    }
+    return 0.5 * (a + b);
+}
+
+/**
+ * Complete elliptic integral of the first kind K(m), parameter m = k^2
+ *
+ * K(m) = pi / (2 * agm(1, sqrt(1 - m))). The complementary integral
+ * K(1 - m) is ellipk_c(m), computed from m itself to keep accuracy when
+ * m is tiny.
+ */
+static double ellipk(double m)
+{
+    return M_PI / (2.0 * agm(1.0, sqrt(1.0 - m)));
+}
+
+static double ellipk_c(double m)
+{
+    return M_PI / (2.0 * agm(1.0, sqrt(m)));
+}
+
+/**
+ * Jacobi elliptic functions sn, cn, dn of u with parameter m
+ *
+ * Descending Landen transformation (AGM) followed by backward
+ * recurrence of the amplitude, as in Cephes ellpj.
+ */
+static void ellipj(double u, double m, double* sn, double* cn, double* dn)
+{
+    double a[ELLIP_MAX_ITER + 1], c[ELLIP_MAX_ITER + 1];
+    double b, phi, twon;
+    int i = 0;
+
+    if (m < 1e-9) {
+        double t = sin(u), s = cos(u);
+        double ai = 0.25 * m * (u - t * s);
+        *sn = t - ai * s;
+        *cn = s + ai * t;
+        *dn = 1.0 - 0.5 * m * t * t;
+        return;
+    }
+    if (m >= 0.9999999999) {
+        double ai = 0.25 * (1.0 - m);
+        double ch = cosh(u), t = tanh(u);
+        double sech = 1.0 / ch;
+        double w = ch * sinh(u);
+        *sn = t + ai * (w - u) / (ch * ch);
+        ai *= t * sech;
+        *cn = sech - ai * (w - u);
+        *dn = sech + ai * (w + u);
+        return;
+    }
+
+    a[0] = 1.0;
+    b = sqrt(1.0 - m);
+    c[0] = sqrt(m);
+    twon = 1.0;
+    while (fabs(c[i] / a[i]) > DBL_EPSILON && i < ELLIP_MAX_ITER) {
+        double ai = a[i];
+        i++;
+        c[i] = 0.5 * (ai - b);
+        a[i] = 0.5 * (ai + b);
+        b = sqrt(ai * b);
+        twon *= 2.0;
+    }
+
+    phi = twon * a[i] * u;
+    do {
+        double t = c[i] * sin(phi) / a[i];
+        b = phi;
+        phi = 0.5 * (asin(t) + phi);
+    } while (--i);
+
+    *sn = sin(phi);
+    *cn = cos(phi);
+    *dn = *cn / cos(phi - b);
+}
+
+/**
+ * Parameter m of the elliptic degree equation (scipy _ellipdeg)
+ *
+ * Solves K(1-m)/K(m) = N * K(1-m1)/K(m1) for m through the nome
+ * q = q1^(1/N), q1 = exp(-pi K(1-m1)/K(m1)).
+ */
+static double ellipdeg(int order, double m1)
+{
+    const double q1 = exp(-M_PI * ellipk_c(m1) / ellipk(m1));
+    const double q = pow(q1, 1.0 / order);
+    double num = 0.0, den = 0.0;
+
+    for (int i = 0; i <= ELLIPDEG_TERMS; i++) {
+        num += pow(q, (double)(i * (i + 1)));
+    }
+    for (int i = 1; i <= ELLIPDEG_TERMS + 1; i++) {
+        den += pow(q, (double)(i * i));
+    }
+    den = 1.0 + 2.0 * den;
+
+    const double r = num / den;
+    return 16.0 * q * r * r * r * r;
+}
+
+/**
+ * Inverse of the Jacobi sc function: u such that sc(u, m) = w
+ *
+ * scipy computes it as Im(arcsn(j w, m)) by ascending Landen
+ * transformations; for a purely imaginary argument every step stays
+ * imaginary, so it reduces to real arithmetic on w.
+ */
+static double arc_jac_sc1(double w, double m)
+{
+    double ks[ELLIP_MAX_ITER + 1];
+    int n = 0;
+
+    ks[0] = sqrt(m);
+    while (ks[n] != 0.0 && n < ELLIP_MAX_ITER) {
+        const double kp = sqrt((1.0 - ks[n]) * (1.0 + ks[n]));
+        ks[n + 1] = (1.0 - kp) / (1.0 + kp);
+        n++;
+    }
+
+    double capk = M_PI / 2.0;
+    double y = w;
+    for (int i = 0; i < n; i++) {
+        capk *= 1.0 + ks[i + 1];
+        y = 2.0 * y / ((1.0 + ks[i + 1]) * (1.0 + sqrt(1.0 + ks[i] * ks[i] * y * y)));
+    }
+    return capk * 2.0 / M_PI * asinh(y);
+}
+
+/**
+ * Elliptic analog prototype (scipy.signal.ellipap)
+ *
+ * With eps^2 = 10^(rp/10) - 1 and the selectivity from
+ * ck1^2 = eps^2 / (10^(rs/10) - 1), m solves the degree equation and
+ * K = K(m). For j = 1 - N mod 2, 3 - N mod 2, ... below N:
+ *   zeros  z = +/- j / (sqrt(m) * sn(j K / N, m))
+ *   poles  p = -(cn dn sn' cn' + j sn dn') / (1 - (dn sn')^2)
+ * where sn, cn, dn are at (j K / N, m) and sn', cn', dn' at (v0, 1 - m),
+ * v0 = K * arcsc(1/eps, ck1^2) / (N * K(ck1^2)). The response is -rp dB
+ * at 1 rad/s and at most -rs dB in the stopband; DC gain is 1 for odd N
+ * and 1/sqrt(1 + eps^2) for even N.
+ *
+ * @param order Filter order N
+ * @param rp_db Passband ripple (dB)
+ * @param rs_db Stopband attenuation (dB)
+ * @param proto Output prototype
+ */
+static void ellip_prototype(int order, double rp_db, double rs_db, iirdsp_prototype_t* proto)
+{
+    const double eps_sq = pow(10.0, 0.1 * rp_db) - 1.0;
+    int num_poles = 0, num_zeros = 0;
+
+    proto->dc_gain = (order % 2) ? 1.0 : 1.0 / sqrt(1.0 + eps_sq);
+
+    if (order == 1) {
+        proto->poles[0] = -1.0 / sqrt(eps_sq);
+        proto->poles[1] = 0.0;
+        proto->num_poles = 1;
+        proto->num_zeros = 0;
+        return;
+    }
+
+    const double ck1_sq = eps_sq / (pow(10.0, 0.1 * rs_db) - 1.0);
+    const double m = ellipdeg(order, ck1_sq);
+    const double capk = ellipk(m);
+    const double v0 = capk * arc_jac_sc1(1.0 / sqrt(eps_sq), ck1_sq) / (order * ellipk(ck1_sq));
+    double sv, cv, dv;
+
+    ellipj(v0, 1.0 - m, &sv, &cv, &dv);
+
+    for (int j = 1 - order % 2; j < order; j += 2) {
+        double s, c, d;
+        ellipj(j * capk / order, m, &s, &c, &d);
+
+        if (fabs(s) > DBL_EPSILON) {
+            const double z_im = 1.0 / (sqrt(m) * s);
+            proto->zeros[2*num_zeros]     = 0.0;
+            proto->zeros[2*num_zeros + 1] = z_im;
+            num_zeros++;
+            proto->zeros[2*num_zeros]     = 0.0;
+            proto->zeros[2*num_zeros + 1] = -z_im;
+            num_zeros++;
+        }
+
+        const double den = 1.0 - (d * sv) * (d * sv);
+        const double p_re = -c * d * sv * cv / den;
+        const double p_im = -s * dv / den;
+        proto->poles[2*num_poles]     = p_re;
+        proto->poles[2*num_poles + 1] = p_im;
+        num_poles++;
+        if (fabs(p_im) > DBL_EPSILON * hypot(p_re, p_im)) {
+            proto->poles[2*num_poles]     = p_re;
+            proto->poles[2*num_poles + 1] = -p_im;
+            num_poles++;
+        }
+    }
+    proto->num_poles = num_poles;
+    proto->num_zeros = num_zeros;
+}
+
+/**
+ * Validate, build the prototype and design
+ */
+static int ellip_design(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_btype_t type,
+    iirdsp_real f1_hz,
+    iirdsp_real f2_hz,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_prototype_t proto;
+
+    if (order <= 0 || order > IIRDSP_DESIGN_MAX_ORDER) {
+        return -1;  /* Invalid order */
+    }
+    if (!(rp_db > 0.0) || !(rs_db > rp_db)) {
+        return -3;  /* Invalid ripple / attenuation */
+    }
+    ellip_prototype(order, rp_db, rs_db, &proto);
+    return iirdsp_design_analog_filter(f, &proto, type, f1_hz, f2_hz, fs_hz);
+}
+
+/**
+ * Elliptic low-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order
+ * @param rp_db Passband ripple (dB)
+ * @param rs_db Stopband attenuation (dB)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int ellip_lowpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    return ellip_design(f, order, rp_db, rs_db, IIRDSP_LOWPASS, cutoff_hz, 0.0, fs_hz);
+}
+
+/**
+ * Elliptic high-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order
+ * @param rp_db Passband ripple (dB)
+ * @param rs_db Stopband attenuation (dB)
+ * @param cutoff_hz Passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int ellip_highpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_real cutoff_hz,
+    iirdsp_real fs_hz
+)
+{
+    return ellip_design(f, order, rp_db, rs_db, IIRDSP_HIGHPASS, cutoff_hz, 0.0, fs_hz);
+}
+
+/**
+ * Elliptic band-pass filter initialization
+ *
+ * @param f Filter structure to initialize
+ * @param order Filter order (band-pass will produce 2*order poles)
+ * @param rp_db Passband ripple (dB)
+ * @param rs_db Stopband attenuation (dB)
+ * @param f_low_hz Low passband edge (Hz)
+ * @param f_high_hz High passband edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int ellip_bandpass_init(
+    iirdsp_filter_t* f,
+    int order,
+    iirdsp_real rp_db,
+    iirdsp_real rs_db,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz
+)
+{
+    return ellip_design(f, order, rp_db, rs_db, IIRDSP_BANDPASS, f_low_hz, f_high_hz, fs_hz);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file errfb.c
+ * @brief Float cascade with error feedback implementation
+ *
+ * two_sum is Knuth's error-free addition: s = fl(a + b) and e = a + b - s
+ * exactly, for any ordering of |a| and |b|. The product error
+ * fmaf(a, b, -p) is exact for p = fl(a * b). The residuals are summed in
+ * plain float: they are ~2^-24 of the output, so their own rounding is
+ * negligible.
+ */
+
+#include "errfb.h"
+#include "response.h"
+#include "measure.h"
+#include <math.h>
+
+static inline float two_sum(float a, float b, float* err)
+{
+    const float s = a + b;
+    const float bb = s - a;
+    *err = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+/* acc + c * v with the error (product and sum) added to *err */
+static inline float add_product(float acc, float c, float v, float* err)
+{
+    const float p = c * v;
+    float e;
+    acc = two_sum(acc, p, &e);
+    *err += e + fmaf(c, v, -p);
+    return acc;
+}
+
+/**
+ * Build a float cascade from a designed filter, choosing error feedback
+ * per section
+ *
+ * @param c Cascade to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param min_feedback_radius Smallest pole radius given error feedback
+ * @return Number of sections with error feedback
+ */
+int iirdsp_errfb_init(iirdsp_errfb_t* c, const iirdsp_filter_t* f, double min_feedback_radius)
+{
+    int num_feedback = 0;
+
+    for (int i = 0; i < f->num_sections; i++) {
+        const iirdsp_biquad_t* s = &f->sections[i];
+
+        if (iirdsp_section_pole_radius(s) >= min_feedback_radius) {
+            iirdsp_errfb_section_t* d = &c->fb[i];
+            d->b0 = (float)s->b0;
+            d->b1 = (float)s->b1;
+            d->b2 = (float)s->b2;
+            d->a1 = (float)s->a1;
+            d->a2 = (float)s->a2;
+            d->a1_lo = (float)((double)s->a1 - (double)d->a1);
+            d->a2_lo = (float)((double)s->a2 - (double)d->a2);
+            c->has_feedback[i] = 1;
+            num_feedback++;
+        } else {
+            iirdsp_biquad_f32_t* d = &c->df2t[i];
+            d->b0 = (float)s->b0;
+            d->b1 = (float)s->b1;
+            d->b2 = (float)s->b2;
+            d->a1 = (float)s->a1;
+            d->a2 = (float)s->a2;
+            c->has_feedback[i] = 0;
+        }
+    }
+    c->num_sections = f->num_sections;
+    c->num_feedback = num_feedback;
+    iirdsp_errfb_reset(c);
+
+    return num_feedback;
+}
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param c Cascade
+ */
+void iirdsp_errfb_reset(iirdsp_errfb_t* c)
+{
+    for (int i = 0; i < IIRDSP_MAX_SECTIONS; i++) {
+        iirdsp_errfb_section_t* s = &c->fb[i];
+        c->df2t[i].z1 = 0.0f;
+        c->df2t[i].z2 = 0.0f;
+        s->x1 = s->x2 = 0.0f;
+        s->y1 = s->y2 = 0.0f;
+        s->e1 = s->e2 = 0.0f;
+    }
+}
+
+/**
+ * Process a single float sample
+ *
+ * @param c Cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+float iirdsp_errfb_process_sample(iirdsp_errfb_t* c, float x)
+{
+    for (int i = 0; i < c->num_sections; i++) {
+        if (c->has_feedback[i]) {
+            iirdsp_errfb_section_t* s = &c->fb[i];
+            float acc = -s->a1 * s->y1;
+            float d = fmaf(-s->a1, s->y1, -acc);
+            float e, y;
+
+            acc = add_product(acc, -s->a2, s->y2, &d);
+            acc = add_product(acc, s->b0, x, &d);
+            acc = add_product(acc, s->b1, s->x1, &d);
+            acc = add_product(acc, s->b2, s->x2, &d);
+            d -= s->a1 * s->e1 + s->a2 * s->e2 + s->a1_lo * s->y1 + s->a2_lo * s->y2;
+            y = two_sum(acc, d, &e);
+
+            s->x2 = s->x1;
+            s->x1 = x;
+            s->y2 = s->y1;
+            s->y1 = y;
+            s->e2 = s->e1;
+            s->e1 = e;
+            x = y;
+        } else {
+            iirdsp_biquad_f32_t* s = &c->df2t[i];
+            const float y = s->b0 * x + s->z1;
+            s->z1 = s->b1 * x - s->a1 * y + s->z2;
+            s->z2 = s->b2 * x - s->a2 * y;
+            x = y;
+        }
+    }
+    return x;
+}
+
+/**
+ * Process a float buffer
+ *
+ * @param c Cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_errfb_process_buffer(iirdsp_errfb_t* c, const float* x, float* y, int N)
+{
+    for (int n = 0; n < N; n++) {
+        y[n] = iirdsp_errfb_process_sample(c, x[n]);
+    }
+}
+
+/* iirdsp_errfb_process_sample for the shared measurement */
+static float errfb_sample(void* ctx, float x)
+{
+    return iirdsp_errfb_process_sample((iirdsp_errfb_t*)ctx, x);
+}
+
+/**
+ * Measure the output error against the designed filter
+ *
+ * @param c Cascade
+ * @param f Designed filter c was built from
+ * @param num_samples Length of the test signal
+ * @return Relative RMS error
+ */
+double iirdsp_errfb_measure_error(iirdsp_errfb_t* c, const iirdsp_filter_t* f, int num_samples)
+{
+    double err;
+
+    iirdsp_errfb_reset(c);
+    err = iirdsp_measure_float_error(f, errfb_sample, c, num_samples);
+    iirdsp_errfb_reset(c);
+
+    return err;
+}
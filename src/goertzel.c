@@ -0,0 +1,154 @@
+/**
+ * @file goertzel.c
+ * @brief Block-wise Goertzel tone power monitor implementation
+ */
+
+#include "goertzel.h"
+#include "simd.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Initialize a monitor for a set of frequencies
+ *
+ * @param g Monitor to initialize
+ * @param freqs_hz Frequencies to monitor (Hz)
+ * @param num_bins Number of frequencies (1..IIRDSP_GOERTZEL_MAX_BINS)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param block_size Samples per estimate (>= 2)
+ * @return 0 on success, -1 for an invalid bin count, -2 for an invalid
+ *         frequency, -3 for an invalid block size
+ */
+int iirdsp_goertzel_init(
+    iirdsp_goertzel_t* g,
+    const iirdsp_real* freqs_hz,
+    int num_bins,
+    iirdsp_real fs_hz,
+    int block_size
+)
+{
+    if (num_bins < 1 || num_bins > IIRDSP_GOERTZEL_MAX_BINS) {
+        return -1;
+    }
+    for (int k = 0; k < num_bins; k++) {
+        if (!(freqs_hz[k] > 0.0 && freqs_hz[k] < 0.5 * fs_hz)) {
+            return -2;
+        }
+    }
+    if (block_size < 2) {
+        return -3;
+    }
+
+    for (int k = 0; k < IIRDSP_GOERTZEL_MAX_BINS; k++) {
+        g->coef[k] = (k < num_bins) ? 2.0 * cos(2.0 * M_PI * freqs_hz[k] / fs_hz) : 0.0;
+    }
+    g->num_bins = num_bins;
+    g->block_size = block_size;
+    iirdsp_goertzel_reset(g);
+
+    return 0;
+}
+
+/**
+ * Reset state (discard the current block and the last estimates)
+ *
+ * @param g Monitor
+ */
+void iirdsp_goertzel_reset(iirdsp_goertzel_t* g)
+{
+    for (int k = 0; k < IIRDSP_GOERTZEL_MAX_BINS; k++) {
+        g->s1[k] = 0.0;
+        g->s2[k] = 0.0;
+        g->power[k] = 0.0;
+    }
+    g->total_power = 0.0;
+    g->energy = 0.0;
+    g->count = 0;
+}
+
+/*
+ * Run the resonators of all bins over N samples. Each bin is a chain of
+ * dependent multiply-adds, so all vectors of bins advance together per
+ * sample to overlap their latencies.
+ */
+static void goertzel_run(iirdsp_goertzel_t* g, const iirdsp_real* x, int N)
+{
+    enum { MAX_VECS = IIRDSP_GOERTZEL_MAX_BINS / IIRDSP_VEC_LANES };
+    const int V = (g->num_bins + IIRDSP_VEC_LANES - 1) / IIRDSP_VEC_LANES;
+    iirdsp_vec_t c[MAX_VECS], s1[MAX_VECS], s2[MAX_VECS];
+    iirdsp_real energy = g->energy;
+
+    for (int v = 0; v < V; v++) {
+        c[v] = iirdsp_vec_load(&g->coef[v * IIRDSP_VEC_LANES]);
+        s1[v] = iirdsp_vec_load(&g->s1[v * IIRDSP_VEC_LANES]);
+        s2[v] = iirdsp_vec_load(&g->s2[v * IIRDSP_VEC_LANES]);
+    }
+    for (int n = 0; n < N; n++) {
+        const iirdsp_vec_t xv = iirdsp_vec_set1(x[n]);
+        for (int v = 0; v < V; v++) {
+            /* s0 = x + c s1 - s2 */
+            const iirdsp_vec_t s0 = iirdsp_vec_fmadd(c[v], s1[v], iirdsp_vec_sub(xv, s2[v]));
+            s2[v] = s1[v];
+            s1[v] = s0;
+        }
+        energy += x[n] * x[n];
+    }
+    for (int v = 0; v < V; v++) {
+        iirdsp_vec_store(&g->s1[v * IIRDSP_VEC_LANES], s1[v]);
+        iirdsp_vec_store(&g->s2[v * IIRDSP_VEC_LANES], s2[v]);
+    }
+    g->energy = energy;
+}
+
+/**
+ * Feed samples (streaming)
+ *
+ * @param g Monitor
+ * @param x Input signal (length N)
+ * @param N Number of samples
+ * @return Number of blocks completed during this call
+ */
+int iirdsp_goertzel_process(iirdsp_goertzel_t* g, const iirdsp_real* x, int N)
+{
+    const iirdsp_real scale = 2.0 / ((iirdsp_real)g->block_size * g->block_size);
+    int blocks = 0;
+
+    while (N > 0) {
+        const int len = (g->block_size - g->count < N) ? g->block_size - g->count : N;
+
+        goertzel_run(g, x, len);
+        g->count += len;
+        x += len;
+        N -= len;
+
+        if (g->count == g->block_size) {
+            for (int k = 0; k < g->num_bins; k++) {
+                const iirdsp_real s1 = g->s1[k], s2 = g->s2[k];
+                g->power[k] = scale * (s1 * s1 + s2 * s2 - g->coef[k] * s1 * s2);
+                g->s1[k] = 0.0;
+                g->s2[k] = 0.0;
+            }
+            g->total_power = g->energy / g->block_size;
+            g->energy = 0.0;
+            g->count = 0;
+            blocks++;
+        }
+    }
+    return blocks;
+}
+
+/**
+ * Fraction of the last block's power in one bin
+ *
+ * @param g Monitor
+ * @param bin Bin index
+ * @return power[bin] / total_power, or 0 for a silent or missing block
+ */
+iirdsp_real iirdsp_goertzel_fraction(const iirdsp_goertzel_t* g, int bin)
+{
+    return (g->total_power > 0.0) ? g->power[bin] / g->total_power : 0.0;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file halfband.c
+ * @brief Polyphase allpass half-band filters implementation
+ *
+ * Design follows Valenzuela & Constantinides, "Digital signal processing
+ * schemes for efficient interpolation and decimation" (1983): the
+ * half-band elliptic filter of odd order n with selectivity
+ * k = tan^2(pi (1 - 2 tbw) / 4) has its poles on the imaginary axis of the
+ * z^2 plane, and each pole pair gives one allpass coefficient. The nome q
+ * and the Jacobi theta series below evaluate those poles.
+ */
+
+#include "halfband.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Selectivity k and nome q of the half-band elliptic filter */
+static void transition_params(double transition, double* k, double* q)
+{
+    double kksqrt, e, e2, e4;
+
+    *k = tan((1.0 - 2.0 * transition) * M_PI / 4.0);
+    *k *= *k;
+    kksqrt = pow(1.0 - *k * *k, 0.25);
+    e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    e2 = e * e;
+    e4 = e2 * e2;
+    *q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+}
+
+/* i-th allpass coefficient (1-based c) of the order-n design */
+static double allpass_coef(int c, double k, double q, int order)
+{
+    double num = 0.0, den = 0.0, term, ww, x;
+    int i, sign;
+
+    /* Theta series: numerator sum_i (-1)^i q^(i(i+1)) sin((2i+1) c pi / n) */
+    i = 0;
+    sign = 1;
+    do {
+        term = pow(q, i * (i + 1)) * sin((2 * i + 1) * c * M_PI / order) * sign;
+        num += term;
+        sign = -sign;
+        i++;
+    } while (fabs(term) > 1e-100);
+
+    /* Denominator 1/2 + sum_i (-1)^i q^(i^2) cos(2 i c pi / n) */
+    i = 1;
+    sign = -1;
+    do {
+        term = pow(q, i * i) * cos(2 * i * c * M_PI / order) * sign;
+        den += term;
+        sign = -sign;
+        i++;
+    } while (fabs(term) > 1e-100);
+
+    ww = num * pow(q, 0.25) / (den + 0.5);
+    ww *= ww;
+    x = sqrt((1.0 - ww * k) * (1.0 - ww / k)) / (1.0 + ww);
+
+    return (1.0 - x) / (1.0 + x);
+}
+
+/**
+ * Design half-band allpass coefficients for a stopband attenuation
+ *
+ * @param coefs Output coefficients (at least max_coefs)
+ * @param max_coefs Capacity of coefs
+ * @param atten_db Stopband attenuation (dB, > 0)
+ * @param transition Transition band width as a fraction of the high rate
+ * @return Number of coefficients, -2 for an invalid specification, -3 if
+ *         more than max_coefs are needed
+ */
+int iirdsp_halfband_design(iirdsp_real* coefs, int max_coefs, iirdsp_real atten_db, iirdsp_real transition)
+{
+    double k, q, stop_power, a;
+    int order, num_coefs;
+
+    if (!(atten_db > 0.0) || !(transition > 0.0 && transition < 0.5)) {
+        return -2;
+    }
+
+    /* Smallest odd order whose stopband ripple reaches atten_db */
+    transition_params(transition, &k, &q);
+    stop_power = pow(10.0, -atten_db / 10.0);
+    a = stop_power / (1.0 - stop_power);
+    order = (int)ceil(log(a * a / 16.0) / log(q));
+    if (order % 2 == 0) {
+        order++;
+    }
+    if (order < 3) {
+        order = 3;
+    }
+
+    num_coefs = (order - 1) / 2;
+    if (num_coefs > max_coefs) {
+        return -3;
+    }
+    for (int i = 0; i < num_coefs; i++) {
+        coefs[i] = (iirdsp_real)allpass_coef(i + 1, k, q, order);
+    }
+
+    return num_coefs;
+}
+
+/**
+ * Initialize one stage from a stopband specification
+ *
+ * @param h Stage to initialize (state is zeroed)
+ * @param atten_db Stopband attenuation (dB)
+ * @param transition Transition band width as a fraction of the high rate
+ * @return 0 on success, -2 for an invalid specification, -3 if the design
+ *         needs more than IIRDSP_HALFBAND_MAX_COEFS coefficients
+ */
+int iirdsp_halfband_init(iirdsp_halfband_t* h, iirdsp_real atten_db, iirdsp_real transition)
+{
+    int n = iirdsp_halfband_design(h->coefs, IIRDSP_HALFBAND_MAX_COEFS, atten_db, transition);
+
+    if (n < 0) {
+        return n;
+    }
+    h->num_coefs = n;
+    iirdsp_halfband_reset(h);
+
+    return 0;
+}
+
+/**
+ * Reset stage state (zero all history)
+ *
+ * @param h Stage
+ */
+void iirdsp_halfband_reset(iirdsp_halfband_t* h)
+{
+    for (int i = 0; i < IIRDSP_HALFBAND_MAX_COEFS; i++) {
+        h->x1[i] = 0.0;
+        h->y1[i] = 0.0;
+    }
+}
+
+/* Run one low-rate sample through the branch of coefficients first, first + 2, ... */
+static inline iirdsp_real branch(iirdsp_halfband_t* h, int first, iirdsp_real x)
+{
+    for (int i = first; i < h->num_coefs; i += 2) {
+        const iirdsp_real y = h->coefs[i] * (x - h->y1[i]) + h->x1[i];
+        h->x1[i] = x;
+        h->y1[i] = y;
+        x = y;
+    }
+    return x;
+}
+
+/**
+ * Filter one high-rate pair and return the low-rate sample
+ *
+ * @param h Stage
+ * @param x0 Older input sample
+ * @param x1 Newer input sample
+ * @return Low-pass filtered output at half the rate
+ */
+iirdsp_real iirdsp_halfband_decimate(iirdsp_halfband_t* h, iirdsp_real x0, iirdsp_real x1)
+{
+    return 0.5 * (branch(h, 0, x1) + branch(h, 1, x0));
+}
+
+/**
+ * Filter one low-rate sample into a high-rate pair
+ *
+ * @param h Stage
+ * @param x Input sample
+ * @param y Output pair, y[0] first in time
+ */
+void iirdsp_halfband_interpolate(iirdsp_halfband_t* h, iirdsp_real x, iirdsp_real* y)
+{
+    y[0] = branch(h, 0, x);
+    y[1] = branch(h, 1, x);
+}
+
+/*
+ * Design stages for a multi-stage converter. The stage at index sharp gets
+ * the given transition; each step away from it widens the transition to
+ * 0.25 + t / 2 (the band that would alias into the final passband).
+ */
+static int init_stages(
+    iirdsp_halfband_t* stages,
+    int num_stages,
+    int sharp,
+    iirdsp_real atten_db,
+    iirdsp_real transition
+)
+{
+    iirdsp_real t = transition;
+
+    if (num_stages < 1 || num_stages > IIRDSP_HALFBAND_MAX_STAGES) {
+        return -1;
+    }
+    for (int s = 0; s < num_stages; s++) {
+        const int index = (sharp == 0) ? s : sharp - s;
+        int ret = iirdsp_halfband_init(&stages[index], atten_db, t);
+        if (ret != 0) {
+            return ret;
+        }
+        t = 0.25 + 0.5 * t;
+    }
+    return 0;
+}
+
+/**
+ * Initialize a multi-stage decimator
+ *
+ * @param d Decimator to initialize (state is zeroed)
+ * @param num_stages Number of halvings (1..IIRDSP_HALFBAND_MAX_STAGES)
+ * @param atten_db Stopband attenuation (dB)
+ * @param transition Transition band width of the last stage
+ * @return 0 on success, -1 for an invalid stage count, -2 for an invalid
+ *         specification, -3 if a stage needs too many coefficients
+ */
+int iirdsp_halfband_decimator_init(
+    iirdsp_halfband_decimator_t* d,
+    int num_stages,
+    iirdsp_real atten_db,
+    iirdsp_real transition
+)
+{
+    int ret = init_stages(d->stages, num_stages, num_stages - 1, atten_db, transition);
+
+    if (ret != 0) {
+        return ret;
+    }
+    d->num_stages = num_stages;
+    iirdsp_halfband_decimator_reset(d);
+
+    return 0;
+}
+
+/**
+ * Reset decimator state (zero all history and pending samples)
+ *
+ * @param d Decimator
+ */
+void iirdsp_halfband_decimator_reset(iirdsp_halfband_decimator_t* d)
+{
+    for (int s = 0; s < IIRDSP_HALFBAND_MAX_STAGES; s++) {
+        iirdsp_halfband_reset(&d->stages[s]);
+        d->pending[s] = 0.0;
+        d->has_pending[s] = 0;
+    }
+}
+
+/**
+ * Decimate a buffer (streaming)
+ *
+ * @param d Decimator
+ * @param x Input signal (length N)
+ * @param N Number of input samples
+ * @param y Output signal, may alias x
+ * @return Number of output samples written
+ */
+int iirdsp_halfband_decimator_process(
+    iirdsp_halfband_decimator_t* d,
+    const iirdsp_real* x,
+    int N,
+    iirdsp_real* y
+)
+{
+    int count = 0;
+
+    for (int n = 0; n < N; n++) {
+        iirdsp_real v = x[n];
+        int s;
+
+        /* Carry the sample down the stages while each completes a pair */
+        for (s = 0; s < d->num_stages; s++) {
+            if (!d->has_pending[s]) {
+                d->pending[s] = v;
+                d->has_pending[s] = 1;
+                break;
+            }
+            v = iirdsp_halfband_decimate(&d->stages[s], d->pending[s], v);
+            d->has_pending[s] = 0;
+        }
+        if (s == d->num_stages) {
+            y[count++] = v;
+        }
+    }
+    return count;
+}
+
+/**
+ * Initialize a multi-stage interpolator
+ *
+ * @param u Interpolator to initialize (state is zeroed)
+ * @param num_stages Number of doublings (1..IIRDSP_HALFBAND_MAX_STAGES)
+ * @param atten_db Stopband attenuation (dB)
+ * @param transition Transition band width of stage 0
+ * @return 0 on success, -1 for an invalid stage count, -2 for an invalid
+ *         specification, -3 if a stage needs too many coefficients
+ */
+int iirdsp_halfband_interpolator_init(
+    iirdsp_halfband_interpolator_t* u,
+    int num_stages,
+    iirdsp_real atten_db,
+    iirdsp_real transition
+)
+{
+    int ret = init_stages(u->stages, num_stages, 0, atten_db, transition);
+
+    if (ret != 0) {
+        return ret;
+    }
+    u->num_stages = num_stages;
+    iirdsp_halfband_interpolator_reset(u);
+
+    return 0;
+}
+
+/**
+ * Reset interpolator state (zero all history)
+ *
+ * @param u Interpolator
+ */
+void iirdsp_halfband_interpolator_reset(iirdsp_halfband_interpolator_t* u)
+{
+    for (int s = 0; s < IIRDSP_HALFBAND_MAX_STAGES; s++) {
+        iirdsp_halfband_reset(&u->stages[s]);
+    }
+}
+
+/**
+ * Interpolate a buffer (streaming)
+ *
+ * @param u Interpolator
+ * @param x Input signal (length N)
+ * @param N Number of input samples
+ * @param y Output signal (length N * 2^num_stages), must not alias x
+ */
+void iirdsp_halfband_interpolator_process(
+    iirdsp_halfband_interpolator_t* u,
+    const iirdsp_real* x,
+    int N,
+    iirdsp_real* y
+)
+{
+    const int factor = 1 << u->num_stages;
+
+    for (int n = 0; n < N; n++) {
+        iirdsp_real* out = &y[n * factor];
+        iirdsp_real in[1 << (IIRDSP_HALFBAND_MAX_STAGES - 1)];
+        int len = 1;
+
+        /* Each stage turns sample i of the previous one into 2i, 2i + 1 */
+        out[0] = x[n];
+        for (int s = 0; s < u->num_stages; s++) {
+            for (int i = 0; i < len; i++) {
+                in[i] = out[i];
+            }
+            for (int i = 0; i < len; i++) {
+                iirdsp_halfband_interpolate(&u->stages[s], in[i], &out[2 * i]);
+            }
+            len *= 2;
+        }
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file hilbert.c
+ * @brief Streaming IIR Hilbert transformer implementation
+ */
+
+#include "hilbert.h"
+#include "halfband.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Cascade of (a - z^-2) / (1 - a z^-2) for coefs[first], coefs[first + 2], ... */
+static void build_branch(iirdsp_filter_t* f, const iirdsp_real* coefs, int num_coefs, int first)
+{
+    f->num_sections = 0;
+    for (int k = first; k < num_coefs; k += 2) {
+        iirdsp_biquad_t* s = &f->sections[f->num_sections++];
+        s->b0 = coefs[k];
+        s->b1 = 0.0;
+        s->b2 = -1.0;
+        s->a1 = 0.0;
+        s->a2 = -coefs[k];
+    }
+    iirdsp_filter_init(f);
+}
+
+/**
+ * Design a Hilbert transformer for a band and phase accuracy
+ *
+ * @param h Hilbert transformer to initialize
+ * @param f_low_hz Lower band edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param max_phase_error_deg Largest deviation from 90 degrees in the band
+ * @return 0 on success, -2 for an invalid band, -3 for an invalid phase
+ *         error or too many sections
+ */
+int iirdsp_hilbert_init(
+    iirdsp_hilbert_t* h,
+    iirdsp_real f_low_hz,
+    iirdsp_real fs_hz,
+    iirdsp_real max_phase_error_deg
+)
+{
+    iirdsp_real coefs[2 * IIRDSP_MAX_SECTIONS];
+    iirdsp_real atten_db;
+    int n;
+
+    if (!(fs_hz > 0.0) || !(f_low_hz > 0.0 && f_low_hz < 0.25 * fs_hz)) {
+        return -2;
+    }
+    if (!(max_phase_error_deg > 0.0 && max_phase_error_deg < 90.0)) {
+        return -3;
+    }
+
+    /* Phase error d <-> half-band stopband ripple sin(d / 2) */
+    atten_db = -20.0 * log10(sin(0.5 * max_phase_error_deg * M_PI / 180.0));
+    n = iirdsp_halfband_design(coefs, 2 * IIRDSP_MAX_SECTIONS, atten_db, 2.0 * f_low_hz / fs_hz);
+    if (n < 0) {
+        return -3;
+    }
+
+    build_branch(&h->in_phase, coefs, n, 0);
+    build_branch(&h->quadrature, coefs, n, 1);
+    h->x_prev = 0.0;
+    h->phase_error_deg = max_phase_error_deg;
+
+    return 0;
+}
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param h Hilbert transformer
+ */
+void iirdsp_hilbert_reset(iirdsp_hilbert_t* h)
+{
+    iirdsp_filter_reset(&h->in_phase);
+    iirdsp_filter_reset(&h->quadrature);
+    h->x_prev = 0.0;
+}
+
+/**
+ * Process a single sample into I and Q
+ *
+ * @param h Hilbert transformer
+ * @param x Input sample
+ * @param i In-phase output
+ * @param q Quadrature output
+ */
+void iirdsp_hilbert_process_sample(iirdsp_hilbert_t* h, iirdsp_real x, iirdsp_real* i, iirdsp_real* q)
+{
+    *i = iirdsp_process_sample(&h->in_phase, x);
+    *q = iirdsp_process_sample(&h->quadrature, h->x_prev);
+    h->x_prev = x;
+}
+
+/**
+ * Process a single sample into its envelope sqrt(I^2 + Q^2)
+ *
+ * @param h Hilbert transformer
+ * @param x Input sample
+ * @return Envelope sample
+ */
+iirdsp_real iirdsp_hilbert_envelope_sample(iirdsp_hilbert_t* h, iirdsp_real x)
+{
+    iirdsp_real i, q;
+    iirdsp_hilbert_process_sample(h, x, &i, &q);
+    return sqrt(i * i + q * q);
+}
+
+/**
+ * Process a buffer into I and Q
+ *
+ * @param h Hilbert transformer
+ * @param x Input signal (length N)
+ * @param i In-phase output (length N), may alias x
+ * @param q Quadrature output (length N)
+ * @param N Number of samples
+ */
+void iirdsp_hilbert_process_buffer(
+    iirdsp_hilbert_t* h,
+    const iirdsp_real* x,
+    iirdsp_real* i,
+    iirdsp_real* q,
+    int N
+)
+{
+    for (int n = 0; n < N; n++) {
+        iirdsp_hilbert_process_sample(h, x[n], &i[n], &q[n]);
+    }
+}
+
+/**
+ * Process a buffer into its envelope
+ *
+ * @param h Hilbert transformer
+ * @param x Input signal (length N)
+ * @param env Envelope output (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_hilbert_envelope_buffer(iirdsp_hilbert_t* h, const iirdsp_real* x, iirdsp_real* env, int N)
+{
+    for (int n = 0; n < N; n++) {
+        env[n] = iirdsp_hilbert_envelope_sample(h, x[n]);
+    }
+}
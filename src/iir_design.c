@@ -0,0 +1,458 @@
+/**
+ * @file iir_design.c
+ * @brief Classical digital IIR design pipeline
+ *
+ * Shared by all designers, from a normalized analog low-pass prototype:
+ *   1. Frequency transformation (low-pass, high-pass, band-pass or band-stop)
+ *   2. Bilinear transform with pre-warping
+ *   3. Pole/zero pairing into second-order sections
+ *   4. Gain normalization
+ *
+ * Pairing follows scipy.signal.zpk2sos(..., pairing='nearest'), so the
+ * sections match scipy.signal's designers with output='sos'.
+ */
+
+#include "iir_design.h"
+#include "response.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Map one s-plane root to the z-plane with the bilinear transform
+ *
+ *   z = (1 + s/(2*fs)) / (1 - s/(2*fs))
+ */
+static void bilinear_root(iirdsp_real s_re, iirdsp_real s_im, iirdsp_real fs2,
+                          iirdsp_real* z_re, iirdsp_real* z_im)
+{
+    iirdsp_real num_re = 1.0 + s_re / fs2;
+    iirdsp_real num_im = s_im / fs2;
+    iirdsp_real den_re = 1.0 - s_re / fs2;
+    iirdsp_real den_im = -s_im / fs2;
+
+    /* Complex division */
+    iirdsp_real denom = den_re * den_re + den_im * den_im;
+    *z_re = (num_re * den_re + num_im * den_im) / denom;
+    *z_im = (num_im * den_re - num_re * den_im) / denom;
+}
+
+/**
+ * Treat a root as real if its imaginary part is negligible
+ */
+static int root_is_real(const iirdsp_real* r)
+{
+    return fabs(r[1]) <= 1e-6 * (1.0 + fabs(r[0]));
+}
+
+/**
+ * Index of the unused root nearest to (re, im), optionally real roots only
+ *
+ * @return Index, or -1 if no candidate is left
+ */
+static int nearest_root(const iirdsp_real* roots, const int* used, int n,
+                        iirdsp_real re, iirdsp_real im, int real_only)
+{
+    int best = -1;
+    iirdsp_real best_d = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (used[i] || (real_only && !root_is_real(&roots[2*i]))) {
+            continue;
+        }
+        iirdsp_real dr = roots[2*i] - re;
+        iirdsp_real di = roots[2*i + 1] - im;
+        iirdsp_real d = dr * dr + di * di;
+        if (best < 0 || d < best_d) {
+            best = i;
+            best_d = d;
+        }
+    }
+    return best;
+}
+
+/**
+ * Pair digital poles and zeros into second-order sections
+ *
+ * Follows the 'nearest' strategy of scipy.signal.zpk2sos:
+ *   - Poles are taken in order of decreasing radius (closest to the unit
+ *     circle first) and are placed from the last section backwards, so
+ *     the most resonant section runs last in the cascade.
+ *   - A complex pole is paired with its conjugate; a real pole with the
+ *     remaining real pole closest to the unit circle, or alone
+ *     (first-order section) if none is left.
+ *   - Each pole pair takes the zero(s) nearest to it.
+ *
+ * @param poles_z Digital poles (complex pairs: re, im)
+ * @param zeros_z Digital zeros (complex pairs: re, im), same count as poles
+ * @param num_poles Number of poles (and zeros)
+ * @param c Cascade to populate, with room for (num_poles + 1) / 2 sections
+ *          (gain is not normalized)
+ */
+static void zpk_to_sections(
+    const iirdsp_real* poles_z,
+    const iirdsp_real* zeros_z,
+    int num_poles,
+    iirdsp_cascade_t* c
+)
+{
+    int pole_used[IIRDSP_DESIGN_MAX_SECTIONS * 2];
+    int zero_used[IIRDSP_DESIGN_MAX_SECTIONS * 2];
+    for (int i = 0; i < num_poles; i++) {
+        pole_used[i] = 0;
+        zero_used[i] = 0;
+    }
+
+    int num_sections = (num_poles + 1) / 2;
+    c->num_sections = num_sections;
+
+    for (int s = num_sections - 1; s >= 0; s--) {
+        /* Unused pole closest to the unit circle */
+        int ip1 = -1;
+        iirdsp_real best_r = -1.0;
+        for (int i = 0; i < num_poles; i++) {
+            iirdsp_real r = poles_z[2*i] * poles_z[2*i] + poles_z[2*i + 1] * poles_z[2*i + 1];
+            if (!pole_used[i] && r > best_r) {
+                ip1 = i;
+                best_r = r;
+            }
+        }
+        pole_used[ip1] = 1;
+        iirdsp_real p1_re = poles_z[2*ip1];
+        iirdsp_real p1_im = poles_z[2*ip1 + 1];
+
+        /* Its partner: the conjugate, or the next real pole */
+        int ip2 = -1;
+        if (!root_is_real(&poles_z[2*ip1])) {
+            ip2 = nearest_root(poles_z, pole_used, num_poles, p1_re, -p1_im, 0);
+        } else {
+            best_r = -1.0;
+            for (int i = 0; i < num_poles; i++) {
+                iirdsp_real r = fabs(poles_z[2*i]);
+                if (!pole_used[i] && root_is_real(&poles_z[2*i]) && r > best_r) {
+                    ip2 = i;
+                    best_r = r;
+                }
+            }
+        }
+
+        /* Nearest zero(s) */
+        int iz1 = nearest_root(zeros_z, zero_used, num_poles, p1_re, p1_im, ip2 < 0);
+        zero_used[iz1] = 1;
+        iirdsp_real z1_re = zeros_z[2*iz1];
+        iirdsp_real z1_im = zeros_z[2*iz1 + 1];
+
+        iirdsp_biquad_t* sec = &c->sections[s];
+        sec->z1 = 0.0;
+        sec->z2 = 0.0;
+
+        if (ip2 < 0) {
+            /* First-order section: (1 - z1 q) / (1 - p1 q) */
+            sec->b0 = 1.0;
+            sec->b1 = -z1_re;
+            sec->b2 = 0.0;
+            sec->a1 = -p1_re;
+            sec->a2 = 0.0;
+            continue;
+        }
+
+        pole_used[ip2] = 1;
+        iirdsp_real p2_re = poles_z[2*ip2];
+        iirdsp_real p2_im = poles_z[2*ip2 + 1];
+
+        int iz2;
+        if (!root_is_real(&zeros_z[2*iz1])) {
+            iz2 = nearest_root(zeros_z, zero_used, num_poles, z1_re, -z1_im, 0);
+        } else {
+            iz2 = nearest_root(zeros_z, zero_used, num_poles, p1_re, p1_im, 1);
+            if (iz2 < 0) {
+                iz2 = nearest_root(zeros_z, zero_used, num_poles, p1_re, p1_im, 0);
+            }
+        }
+        zero_used[iz2] = 1;
+        iirdsp_real z2_re = zeros_z[2*iz2];
+        iirdsp_real z2_im = zeros_z[2*iz2 + 1];
+
+        /* Numerator: (z - z1)(z - z2) = z^2 - (z1+z2)*z + z1*z2 */
+        sec->b0 = 1.0;
+        sec->b1 = -(z1_re + z2_re);
+        sec->b2 = z1_re * z2_re - z1_im * z2_im;
+
+        /* Denominator: (z - p1)(z - p2) = z^2 - (p1+p2)*z + p1*p2 */
+        sec->a1 = -(p1_re + p2_re);
+        sec->a2 = p1_re * p2_re - p1_im * p2_im;
+    }
+}
+
+/**
+ * Apply bilinear transform to convert an analog zpk design to SOS
+ *
+ * Bilinear transform: s = 2*fs * (z-1)/(z+1)
+ *
+ * Each analog root s_k maps to the digital root:
+ *   z_k = (1 + s_k/(2*fs)) / (1 - s_k/(2*fs))
+ *
+ * The digital filter has as many zeros as poles. Analog zeros at
+ * s = infinity map to z = -1 and analog zeros at s = 0 map to z = +1, so
+ * the (num_poles - num_zeros) missing zeros are placed at:
+ *   - low-pass:  z = -1
+ *   - high-pass: z = +1
+ *   - band-pass: half at z = +1, half at z = -1
+ * Band-stop designs have all their zeros finite (on +/-j*w0).
+ *
+ * @param poles_s Analog poles (complex pairs: re, im)
+ * @param zeros_s Analog zeros (complex pairs: re, im), NULL for all-pole filter
+ * @param num_poles Number of poles
+ * @param num_zeros Number of finite analog zeros (0 for all-pole prototypes)
+ * @param fs_hz Sampling frequency
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS, IIRDSP_BANDPASS or IIRDSP_BANDSTOP
+ * @param c Cascade to populate
+ */
+static void bilinear_zpk(
+    const iirdsp_real* poles_s,
+    const iirdsp_real* zeros_s,
+    int num_poles,
+    int num_zeros,
+    iirdsp_real fs_hz,
+    iirdsp_btype_t type,
+    iirdsp_cascade_t* c
+)
+{
+    iirdsp_real fs2 = 2.0 * fs_hz;
+
+    /* Convert analog poles to digital */
+    iirdsp_real poles_z[2 * IIRDSP_DESIGN_MAX_SECTIONS * 2];
+    for (int i = 0; i < num_poles; i++) {
+        bilinear_root(poles_s[2*i], poles_s[2*i + 1], fs2, &poles_z[2*i], &poles_z[2*i + 1]);
+    }
+
+    /* Convert finite analog zeros, then place the zeros at infinity / DC */
+    iirdsp_real zeros_z[2 * IIRDSP_DESIGN_MAX_SECTIONS * 2];
+    for (int i = 0; i < num_zeros; i++) {
+        bilinear_root(zeros_s[2*i], zeros_s[2*i + 1], fs2, &zeros_z[2*i], &zeros_z[2*i + 1]);
+    }
+
+    int num_pad = num_poles - num_zeros;
+    for (int i = 0; i < num_pad; i++) {
+        iirdsp_real z;
+        if (type == IIRDSP_LOWPASS) {          /* Low-pass: zeros at z = -1 */
+            z = -1.0;
+        } else if (type == IIRDSP_HIGHPASS) {  /* High-pass: zeros at z = +1 */
+            z = 1.0;
+        } else {                               /* Band-pass: zeros at z = +1 and z = -1 */
+            z = (i < num_pad / 2) ? 1.0 : -1.0;
+        }
+        zeros_z[2*(num_zeros + i)]     = z;
+        zeros_z[2*(num_zeros + i) + 1] = 0.0;
+    }
+
+    /* Pair poles and zeros into second-order sections */
+    zpk_to_sections(poles_z, zeros_z, num_poles, c);
+}
+
+/**
+ * Normalize filter gain at specified frequency
+ *
+ * The designs here have a real, positive response at the normalization
+ * frequency (DC, Nyquist, or the band-pass center), so the signed real
+ * gain is divided out rather than just its magnitude.
+ *
+ * @param c Cascade to normalize
+ * @param freq Frequency (normalized: 0=DC, 0.5=Nyquist)
+ * @param target Gain wanted at freq
+ */
+static void normalize_gain(iirdsp_cascade_t* c, iirdsp_real freq, iirdsp_real target)
+{
+    iirdsp_real mag, phase;
+    iirdsp_cascade_sosfreqz(c, &freq, 1, 1.0, &mag, &phase, NULL);
+
+    if (mag > 1e-10) {
+        iirdsp_real gain = ((cos(phase) >= 0.0) ? mag : -mag) / target;
+
+        /* Normalize first section's numerator */
+        c->sections[0].b0 /= gain;
+        c->sections[0].b1 /= gain;
+        c->sections[0].b2 /= gain;
+    }
+}
+
+/**
+ * Move prototype roots to the requested band
+ *
+ *   low-pass:  s -> s / wc                  (root r becomes r * wc)
+ *   high-pass: s -> wc / s                  (root r becomes wc / r)
+ *   band-pass: s -> (s^2 + w0^2) / (s * BW)  (root r becomes the two roots of
+ *                                            s^2 - r*BW*s + w0^2 = 0)
+ *   band-stop: s -> (s * BW) / (s^2 + w0^2)  (root r becomes the two roots of
+ *                                            s^2 - (BW/r)*s + w0^2 = 0)
+ *
+ * @param in Prototype roots (complex pairs: re, im)
+ * @param n Number of prototype roots
+ * @param out Transformed roots (n, or 2n for band-pass and band-stop)
+ * @return Number of transformed roots
+ */
+static int transform_roots(
+    const iirdsp_real* in,
+    int n,
+    iirdsp_btype_t type,
+    iirdsp_real wc1,
+    iirdsp_real wc2,
+    iirdsp_real* out
+)
+{
+    if (type == IIRDSP_LOWPASS) {
+        for (int i = 0; i < n; i++) {
+            out[2*i]     = in[2*i] * wc1;
+            out[2*i + 1] = in[2*i + 1] * wc1;
+        }
+        return n;
+    }
+
+    if (type == IIRDSP_HIGHPASS) {
+        for (int i = 0; i < n; i++) {
+            iirdsp_real r_re = in[2*i];
+            iirdsp_real r_im = in[2*i + 1];
+            iirdsp_real mag_sq = r_re * r_re + r_im * r_im;
+
+            /* Invert and scale: wc / r = wc * conj(r) / |r|^2 */
+            out[2*i]     =  r_re * wc1 / mag_sq;
+            out[2*i + 1] = -r_im * wc1 / mag_sq;
+        }
+        return n;
+    }
+
+    iirdsp_real w0 = sqrt(wc1 * wc2);  /* Center frequency */
+    iirdsp_real bw = wc2 - wc1;         /* Bandwidth */
+    int count = 0;
+
+    for (int i = 0; i < n; i++) {
+        /* s = h +/- sqrt(h^2 - w0^2), h = r*BW/2 (band-pass) or BW/(2r) */
+        iirdsp_real h_re, h_im;
+        if (type == IIRDSP_BANDPASS) {
+            h_re = in[2*i] * bw / 2.0;
+            h_im = in[2*i + 1] * bw / 2.0;
+        } else {
+            iirdsp_real mag_sq = in[2*i] * in[2*i] + in[2*i + 1] * in[2*i + 1];
+            h_re =  in[2*i] * bw / (2.0 * mag_sq);
+            h_im = -in[2*i + 1] * bw / (2.0 * mag_sq);
+        }
+
+        /* Discriminant d = h^2 - w0^2 */
+        iirdsp_real d_re = h_re * h_re - h_im * h_im - w0 * w0;
+        iirdsp_real d_im = 2.0 * h_re * h_im;
+
+        /* Principal complex square root of d */
+        iirdsp_real d_mag = sqrt(d_re * d_re + d_im * d_im);
+        iirdsp_real r_re = sqrt((d_mag + d_re) / 2.0);
+        iirdsp_real r_im = copysign(sqrt((d_mag - d_re) / 2.0), d_im);
+
+        out[2*count]     = h_re + r_re;
+        out[2*count + 1] = h_im + r_im;
+        count++;
+        out[2*count]     = h_re - r_re;
+        out[2*count + 1] = h_im - r_im;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Digital filter from an analog prototype
+ *
+ * @param c Cascade to initialize
+ * @param proto Analog prototype
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS, IIRDSP_BANDPASS or IIRDSP_BANDSTOP
+ * @param f1_hz Band edge (Hz); band-pass/band-stop: low edge
+ * @param f2_hz Band-pass/band-stop high edge (Hz), ignored otherwise
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 on too many sections, -2 on invalid frequencies
+ */
+int iirdsp_design_analog(
+    iirdsp_cascade_t* c,
+    const iirdsp_prototype_t* proto,
+    iirdsp_btype_t type,
+    iirdsp_real f1_hz,
+    iirdsp_real f2_hz,
+    iirdsp_real fs_hz
+)
+{
+    const int two_edges = (type == IIRDSP_BANDPASS || type == IIRDSP_BANDSTOP);
+    const int num_sections = two_edges ? proto->num_poles : (proto->num_poles + 1) / 2;
+
+    if (num_sections > IIRDSP_DESIGN_MAX_SECTIONS || num_sections > c->max_sections) {
+        return -1;  /* Too many sections, or more than c can hold */
+    }
+    if (two_edges) {
+        if (f1_hz <= 0.0 || f2_hz <= f1_hz || f2_hz >= fs_hz / 2.0) {
+            return -2;  /* Invalid frequency range */
+        }
+    } else if (f1_hz <= 0.0 || f1_hz >= fs_hz / 2.0) {
+        return -2;  /* Invalid cutoff frequency */
+    }
+
+    /* Pre-warp the band edges */
+    iirdsp_real wc1 = 2.0 * fs_hz * tan(M_PI * f1_hz / fs_hz);
+    iirdsp_real wc2 = two_edges ? 2.0 * fs_hz * tan(M_PI * f2_hz / fs_hz) : wc1;
+
+    iirdsp_real poles_s[2 * IIRDSP_DESIGN_MAX_SECTIONS * 2];
+    iirdsp_real zeros_s[2 * IIRDSP_DESIGN_MAX_SECTIONS * 2];
+    int num_poles = transform_roots(proto->poles, proto->num_poles, type, wc1, wc2, poles_s);
+    int num_zeros = transform_roots(proto->zeros, proto->num_zeros, type, wc1, wc2, zeros_s);
+
+    /* Band-stop: the prototype's zeros at infinity land on +/-j*w0 */
+    if (type == IIRDSP_BANDSTOP) {
+        const iirdsp_real w0 = sqrt(wc1 * wc2);
+        for (int i = proto->num_zeros; i < proto->num_poles; i++) {
+            zeros_s[2*num_zeros]     = 0.0;
+            zeros_s[2*num_zeros + 1] = w0;
+            num_zeros++;
+            zeros_s[2*num_zeros]     = 0.0;
+            zeros_s[2*num_zeros + 1] = -w0;
+            num_zeros++;
+        }
+    }
+
+    bilinear_zpk(poles_s, zeros_s, num_poles, num_zeros, fs_hz, type, c);
+
+    /* The prototype's DC maps to DC, Nyquist, or the image of w0 */
+    if (type == IIRDSP_LOWPASS || type == IIRDSP_BANDSTOP) {
+        normalize_gain(c, 0.0, proto->dc_gain);
+    } else if (type == IIRDSP_HIGHPASS) {
+        normalize_gain(c, 0.5, proto->dc_gain);
+    } else {
+        normalize_gain(c, atan(sqrt(wc1 * wc2) / (2.0 * fs_hz)) / M_PI, proto->dc_gain);
+    }
+    return 0;
+}
+
+/**
+ * iirdsp_design_analog into a fixed-size filter
+ *
+ * @param f Filter structure to initialize
+ * @param proto Analog prototype
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS, IIRDSP_BANDPASS or IIRDSP_BANDSTOP
+ * @param f1_hz Band edge (Hz); band-pass/band-stop: low edge
+ * @param f2_hz Band-pass/band-stop high edge (Hz), ignored otherwise
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_design_analog_filter(
+    iirdsp_filter_t* f,
+    const iirdsp_prototype_t* proto,
+    iirdsp_btype_t type,
+    iirdsp_real f1_hz,
+    iirdsp_real f2_hz,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_cascade_t c;
+    iirdsp_cascade_init(&c, f->sections, IIRDSP_MAX_SECTIONS);
+
+    int ret = iirdsp_design_analog(&c, proto, type, f1_hz, f2_hz, fs_hz);
+    if (ret == 0) {
+        f->num_sections = c.num_sections;
+    }
+    return ret;
+}
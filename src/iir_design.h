@@ -0,0 +1,82 @@
+/**
+ * @file iir_design.h
+ * @brief Internal classical IIR design pipeline shared by the designers
+ *
+ * Every family (Butterworth, Chebyshev I/II, elliptic) only differs in its
+ * normalized analog low-pass prototype. Frequency transformation, the
+ * bilinear transform, pole/zero pairing and gain normalization are common
+ * and live in iir_design.c.
+ * Not part of the public API.
+ */
+
+#ifndef IIRDSP_IIR_DESIGN_H
+#define IIRDSP_IIR_DESIGN_H
+
+#include "config.h"
+#include "sos.h"
+#include "butter.h"
+
+/* Most prototype poles a design can have (low-pass/high-pass order) */
+#define IIRDSP_DESIGN_MAX_ORDER (2 * IIRDSP_DESIGN_MAX_SECTIONS)
+
+/**
+ * Analog low-pass prototype, band edge at 1 rad/s
+ *
+ * Roots are complex pairs (re, im). Zeros are the finite ones only; the
+ * remaining num_poles - num_zeros zeros are at infinity.
+ */
+typedef struct {
+    iirdsp_real poles[2 * IIRDSP_DESIGN_MAX_ORDER];
+    iirdsp_real zeros[2 * IIRDSP_DESIGN_MAX_ORDER];
+    int num_poles;
+    int num_zeros;
+    iirdsp_real dc_gain;  /* |H(0)|: 1, or 10^(-rp/20) for even equiripple passbands */
+} iirdsp_prototype_t;
+
+/**
+ * Digital filter from an analog prototype
+ *
+ * Transforms the prototype to the requested band (pre-warped edges),
+ * applies the bilinear transform, pairs poles and zeros into sections and
+ * scales the gain so the response at DC (low-pass, band-stop), Nyquist
+ * (high-pass) or the band centre (band-pass) equals proto->dc_gain.
+ *
+ * @param c Cascade to initialize
+ * @param proto Analog prototype
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS, IIRDSP_BANDPASS or IIRDSP_BANDSTOP
+ * @param f1_hz Band edge (Hz); band-pass/band-stop: low edge
+ * @param f2_hz Band-pass/band-stop high edge (Hz), ignored otherwise
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -1 on too many sections for c or for
+ *         IIRDSP_DESIGN_MAX_SECTIONS, -2 on invalid frequencies
+ */
+int iirdsp_design_analog(
+    iirdsp_cascade_t* c,
+    const iirdsp_prototype_t* proto,
+    iirdsp_btype_t type,
+    iirdsp_real f1_hz,
+    iirdsp_real f2_hz,
+    iirdsp_real fs_hz
+);
+
+/**
+ * iirdsp_design_analog into a fixed-size filter
+ *
+ * @param f Filter structure to initialize
+ * @param proto Analog prototype
+ * @param type IIRDSP_LOWPASS, IIRDSP_HIGHPASS, IIRDSP_BANDPASS or IIRDSP_BANDSTOP
+ * @param f1_hz Band edge (Hz); band-pass/band-stop: low edge
+ * @param f2_hz Band-pass/band-stop high edge (Hz), ignored otherwise
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_design_analog_filter(
+    iirdsp_filter_t* f,
+    const iirdsp_prototype_t* proto,
+    iirdsp_btype_t type,
+    iirdsp_real f1_hz,
+    iirdsp_real f2_hz,
+    iirdsp_real fs_hz
+);
+
+#endif /* IIRDSP_IIR_DESIGN_H */
@@ -0,0 +1,322 @@
+/**
+ * @file lookahead.c
+ * @brief Scattered look-ahead biquad cascade implementation
+ *
+ * For a section with denominator A_0(w) = 1 + a1 w + a2 w^2 (w = z^-1),
+ * multiplying by A_0(-w) removes the odd powers:
+ *   A_0(w) A_0(-w) = 1 + (2 a2 - a1^2) w^2 + a2^2 w^4 = A_1(w^2)
+ * Repeating L times gives the scattered denominator A_L(z^-M), M = 2^L,
+ * with alpha_{k+1} = 2 beta_k - alpha_k^2 and beta_{k+1} = beta_k^2.
+ * The numerator picks up the factors A_k(-z^-2^k), each a sparse
+ * three-tap FIR.
+ *
+ * All stages of a section run in place over one block buffer that is
+ * prefixed with the stage's history:
+ *   - FIR stages run backwards one simd.h vector at a time, so each
+ *     output overwrites inputs that are no longer needed.
+ *   - The recursive stage runs forwards in groups of M independent lanes,
+ *     as M / IIRDSP_VEC_LANES vectors; when M is narrower than a vector
+ *     the group runs scalar.
+ * The kernel is specialized per M so the lane loop unrolls.
+ */
+
+#include "lookahead.h"
+#include "simd.h"
+#include <math.h>
+#include <string.h>
+
+/* Samples per processing block (stack scratch, no allocation) */
+#define LOOKAHEAD_BLOCK 256
+
+/* History prefix reserved in front of the block buffer */
+#define LOOKAHEAD_PREFIX (2 * IIRDSP_LOOKAHEAD_MAX_M)
+
+/**
+ * Build an M-step look-ahead form of a designed filter
+ *
+ * @param la Look-ahead cascade to initialize
+ * @param f Designed filter
+ * @param M Look-ahead depth (2, 4 or 8)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_lookahead_init(iirdsp_lookahead_t* la, const iirdsp_filter_t* f, int M)
+{
+    int num_stages;
+    if (M == 2) {
+        num_stages = 1;
+    } else if (M == 4) {
+        num_stages = 2;
+    } else if (M == 8) {
+        num_stages = 3;
+    } else {
+        return -1;  /* Unsupported look-ahead depth */
+    }
+
+    la->M = M;
+    la->num_stages = num_stages;
+    la->num_sections = f->num_sections;
+
+    for (int i = 0; i < f->num_sections; i++) {
+        const iirdsp_biquad_t* s = &f->sections[i];
+        iirdsp_lookahead_section_t* ls = &la->sections[i];
+
+        ls->b0 = s->b0;
+        ls->b1 = s->b1;
+        ls->b2 = s->b2;
+
+        /* Square the denominator up in double: A_k(w) A_k(-w) = A_{k+1}(w^2) */
+        double alpha = s->a1;
+        double beta = s->a2;
+        for (int k = 0; k < num_stages; k++) {
+            ls->alpha[k] = (iirdsp_real)alpha;
+            ls->beta[k] = (iirdsp_real)beta;
+            double next_alpha = 2.0 * beta - alpha * alpha;
+            beta = beta * beta;
+            alpha = next_alpha;
+        }
+        ls->c1 = (iirdsp_real)alpha;
+        ls->c2 = (iirdsp_real)beta;
+    }
+    iirdsp_lookahead_reset(la);
+
+    if (!iirdsp_lookahead_is_stable(la)) {
+        return -2;  /* Source filter is not stable */
+    }
+    return 0;
+}
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param la Look-ahead cascade
+ */
+void iirdsp_lookahead_reset(iirdsp_lookahead_t* la)
+{
+    for (int i = 0; i < la->num_sections; i++) {
+        memset(la->sections[i].x_hist, 0, sizeof(la->sections[i].x_hist));
+        memset(la->sections[i].f_hist, 0, sizeof(la->sections[i].f_hist));
+        memset(la->sections[i].y_hist, 0, sizeof(la->sections[i].y_hist));
+    }
+}
+
+/**
+ * In-place three-tap FIR w[t] = c0 w[t] + c1 w[t-d] + c2 w[t-2d]
+ *
+ * hist holds the 2d input samples preceding this block and is updated
+ * with the last 2d inputs of the block.
+ */
+static inline void fir3_inplace(
+    iirdsp_real* w,
+    int len,
+    int d,
+    iirdsp_real c0,
+    iirdsp_real c1,
+    iirdsp_real c2,
+    iirdsp_real* hist
+)
+{
+    const int span = 2 * d;
+    iirdsp_real tail[2 * IIRDSP_LOOKAHEAD_MAX_M];
+
+    /* Save the inputs the next block needs before they are overwritten */
+    for (int i = 0; i < span; i++) {
+        tail[i] = (len - span + i >= 0) ? w[len - span + i] : hist[len + i];
+    }
+    memcpy(w - span, hist, span * sizeof(iirdsp_real));
+
+    /*
+     * All taps of a vector are loaded before it is stored, and lower
+     * indices are still unmodified, so overlapping lags are safe. The
+     * vector at 0 is computed first and stored last: it covers the
+     * remainder below the last full vector, and its other lanes repeat
+     * that vector's results exactly. Every sample therefore takes the
+     * same path however the input is split into blocks.
+     */
+    if (len >= IIRDSP_VEC_LANES) {
+        const iirdsp_vec_t v0 = iirdsp_vec_set1(c0);
+        const iirdsp_vec_t v1 = iirdsp_vec_set1(c1);
+        const iirdsp_vec_t v2 = iirdsp_vec_set1(c2);
+        iirdsp_vec_t head = iirdsp_vec_mul(v2, iirdsp_vec_load(&w[-span]));
+        head = iirdsp_vec_fmadd(v1, iirdsp_vec_load(&w[-d]), head);
+        head = iirdsp_vec_fmadd(v0, iirdsp_vec_load(&w[0]), head);
+
+        for (int t = len - IIRDSP_VEC_LANES; t > 0; t -= IIRDSP_VEC_LANES) {
+            iirdsp_vec_t acc = iirdsp_vec_mul(v2, iirdsp_vec_load(&w[t - span]));
+            acc = iirdsp_vec_fmadd(v1, iirdsp_vec_load(&w[t - d]), acc);
+            iirdsp_vec_store(&w[t], iirdsp_vec_fmadd(v0, iirdsp_vec_load(&w[t]), acc));
+        }
+        iirdsp_vec_store(&w[0], head);
+    } else {
+        /* Same operations as the vector path */
+        for (int t = len - 1; t >= 0; t--) {
+            w[t] = iirdsp_fmadd(c0, w[t], iirdsp_fmadd(c1, w[t - d], c2 * w[t - span]));
+        }
+    }
+
+    memcpy(hist, tail, span * sizeof(iirdsp_real));
+}
+
+/**
+ * Run one section in place over a block
+ *
+ * w has LOOKAHEAD_PREFIX writable samples in front of it.
+ */
+static inline void lookahead_section_block(
+    iirdsp_lookahead_section_t* s,
+    iirdsp_real* w,
+    int len,
+    const int M,
+    const int num_stages
+)
+{
+    /* Original numerator, then the look-ahead factors A_k(-z^-2^k) */
+    fir3_inplace(w, len, 1, s->b0, s->b1, s->b2, s->x_hist);
+
+    iirdsp_real* hist = s->f_hist;
+    for (int k = 0; k < num_stages; k++) {
+        int d = 1 << k;
+        fir3_inplace(w, len, d, 1.0, -s->alpha[k], s->beta[k], hist);
+        hist += 2 * d;
+    }
+
+    /* Recursive part: M independent lanes per step */
+    const int H = 2 * M;
+    const iirdsp_real c1 = s->c1;
+    const iirdsp_real c2 = s->c2;
+
+    memcpy(w - H, s->y_hist, H * sizeof(iirdsp_real));
+    int t = 0;
+    if (M >= IIRDSP_VEC_LANES) {
+        const iirdsp_vec_t v1 = iirdsp_vec_set1(c1);
+        const iirdsp_vec_t v2 = iirdsp_vec_set1(c2);
+        for (; t + M <= len; t += M) {
+            for (int l = 0; l < M; l += IIRDSP_VEC_LANES) {
+                iirdsp_vec_t v = iirdsp_vec_load(&w[t + l]);
+                v = iirdsp_vec_fnmadd(v1, iirdsp_vec_load(&w[t + l - M]), v);
+                v = iirdsp_vec_fnmadd(v2, iirdsp_vec_load(&w[t + l - H]), v);
+                iirdsp_vec_store(&w[t + l], v);
+            }
+        }
+    } else {
+        for (; t + M <= len; t += M) {
+            for (int l = 0; l < M; l++) {
+                w[t + l] = iirdsp_fnmadd(c2, w[t + l - H], iirdsp_fnmadd(c1, w[t + l - M], w[t + l]));
+            }
+        }
+    }
+    /* Same operations as the vector path */
+    for (; t < len; t++) {
+        w[t] = iirdsp_fnmadd(c2, w[t - H], iirdsp_fnmadd(c1, w[t - M], w[t]));
+    }
+    memcpy(s->y_hist, w + len - H, H * sizeof(iirdsp_real));
+}
+
+/**
+ * Process a buffer of samples through the look-ahead cascade
+ *
+ * @param la Look-ahead cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_lookahead_process_buffer(
+    iirdsp_lookahead_t* la,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+)
+{
+    iirdsp_real buf[LOOKAHEAD_PREFIX + LOOKAHEAD_BLOCK];
+    iirdsp_real* w = buf + LOOKAHEAD_PREFIX;
+
+    /* Blocks shorter than the history span would need partial history shifts */
+    const int min_len = 2 * la->M;
+
+    for (int n = 0; n < N; ) {
+        int len = (N - n < LOOKAHEAD_BLOCK) ? N - n : LOOKAHEAD_BLOCK;
+        memcpy(w, x + n, len * sizeof(iirdsp_real));
+
+        if (len < min_len) {
+            /* Short tail: one sample at a time keeps histories simple */
+            len = 1;
+        }
+
+        for (int i = 0; i < la->num_sections; i++) {
+            iirdsp_lookahead_section_t* s = &la->sections[i];
+            switch (la->M) {
+            case 2:  lookahead_section_block(s, w, len, 2, 1); break;
+            case 4:  lookahead_section_block(s, w, len, 4, 2); break;
+            default: lookahead_section_block(s, w, len, 8, 3); break;
+            }
+        }
+
+        memcpy(y + n, w, len * sizeof(iirdsp_real));
+        n += len;
+    }
+}
+
+/**
+ * Check stability of every scattered denominator
+ *
+ * Jury criterion for 1 + c1 w + c2 w^2: |c2| < 1 and |c1| < 1 + c2.
+ *
+ * @param la Look-ahead cascade
+ * @return 1 if all sections are stable, 0 otherwise
+ */
+int iirdsp_lookahead_is_stable(const iirdsp_lookahead_t* la)
+{
+    for (int i = 0; i < la->num_sections; i++) {
+        iirdsp_real c1 = la->sections[i].c1;
+        iirdsp_real c2 = la->sections[i].c2;
+        if (!(fabs(c2) < 1.0 && fabs(c1) < 1.0 + c2)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Measure the accuracy of a look-ahead cascade against the plain cascade
+ *
+ * @param la Look-ahead cascade
+ * @param f Source filter
+ * @param N Number of test samples
+ * @return Maximum absolute error
+ */
+iirdsp_real iirdsp_lookahead_max_error(
+    const iirdsp_lookahead_t* la,
+    const iirdsp_filter_t* f,
+    int N
+)
+{
+    iirdsp_lookahead_t la_copy = *la;
+    iirdsp_filter_t f_copy = *f;
+    iirdsp_real x[LOOKAHEAD_BLOCK], y_la[LOOKAHEAD_BLOCK], y_ref[LOOKAHEAD_BLOCK];
+    iirdsp_real err = 0.0;
+    uint32_t seed = 12345u;
+
+    iirdsp_lookahead_reset(&la_copy);
+    iirdsp_filter_init(&f_copy);
+
+    for (int n = 0; n < N; n += LOOKAHEAD_BLOCK) {
+        int len = (N - n < LOOKAHEAD_BLOCK) ? N - n : LOOKAHEAD_BLOCK;
+
+        /* Impulse, then uniform noise in [-1, 1) from an LCG */
+        for (int i = 0; i < len; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            x[i] = (n + i == 0) ? 1.0 : ((iirdsp_real)(seed >> 8) / 8388608.0 - 1.0);
+        }
+
+        iirdsp_lookahead_process_buffer(&la_copy, x, y_la, len);
+        iirdsp_process_buffer(&f_copy, x, y_ref, len);
+
+        for (int i = 0; i < len; i++) {
+            iirdsp_real e = fabs(y_la[i] - y_ref[i]);
+            if (e > err) {
+                err = e;
+            }
+        }
+    }
+
+    return err;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file measure.c
+ * @brief Accuracy measurement shared by the float cascades
+ */
+
+#include "measure.h"
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * Relative RMS error of a float-I/O cascade against the designed filter
+ *
+ * @param f Designed filter (state is ignored)
+ * @param process Per-sample processing of the cascade under test
+ * @param ctx Cascade under test
+ * @param num_samples Length of the test signal
+ * @return RMS(error) / RMS(reference output)
+ */
+double iirdsp_measure_float_error(
+    const iirdsp_filter_t* f,
+    iirdsp_float_sample_fn process,
+    void* ctx,
+    int num_samples
+)
+{
+    iirdsp_filter_t ref = *f;
+    uint32_t state = 12345u;
+    double err = 0.0, power = 0.0;
+
+    iirdsp_filter_init(&ref);
+    for (int n = 0; n < num_samples; n++) {
+        state = state * 1664525u + 1013904223u;
+        float x = (float)(state >> 8) / 16777216.0f - 0.5f;  /* Exact in float */
+        double y_ref = iirdsp_process_sample(&ref, x);
+        double e = process(ctx, x) - y_ref;
+        err += e * e;
+        power += y_ref * y_ref;
+    }
+
+    return (power > 0.0) ? sqrt(err / power) : 0.0;
+}
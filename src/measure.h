@@ -0,0 +1,46 @@
+/**
+ * @file measure.h
+ * @brief Internal accuracy measurement shared by the float cascades
+ *
+ * mixed.h and coupled.h run a designed filter with float I/O and report
+ * its error against the filter in iirdsp_real. Both use the same test
+ * signal and error measure, defined here once.
+ * Not part of the public API.
+ */
+
+#ifndef IIRDSP_MEASURE_H
+#define IIRDSP_MEASURE_H
+
+#include "config.h"
+#include "sos.h"
+
+/**
+ * Per-sample processing of the cascade under test
+ *
+ * @param ctx Cascade under test
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+typedef float (*iirdsp_float_sample_fn)(void* ctx, float x);
+
+/**
+ * Relative RMS error of a float-I/O cascade against the designed filter
+ *
+ * Runs num_samples of deterministic white noise in [-0.5, 0.5) through
+ * process and through a copy of f. The noise is float-representable, so
+ * the reference sees the same input. The caller resets the cascade.
+ *
+ * @param f Designed filter (state is ignored)
+ * @param process Per-sample processing of the cascade under test
+ * @param ctx Cascade under test
+ * @param num_samples Length of the test signal
+ * @return RMS(error) / RMS(reference output)
+ */
+double iirdsp_measure_float_error(
+    const iirdsp_filter_t* f,
+    iirdsp_float_sample_fn process,
+    void* ctx,
+    int num_samples
+);
+
+#endif /* IIRDSP_MEASURE_H */
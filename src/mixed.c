@@ -0,0 +1,199 @@
+/**
+ * @file mixed.c
+ * @brief Mixed-precision cascade implementation
+ */
+
+#include "mixed.h"
+#include "response.h"
+#include "measure.h"
+
+/**
+ * Attach a mixed cascade to caller storage (no sections in use yet)
+ *
+ * @param m Mixed cascade
+ * @param wide Double section storage, max_wide entries
+ * @param max_wide Capacity of wide
+ * @param narrow Float section storage, max_narrow entries
+ * @param max_narrow Capacity of narrow
+ */
+void iirdsp_mixed_attach(
+    iirdsp_mixed_t* m,
+    iirdsp_biquad_f64_t* wide,
+    int max_wide,
+    iirdsp_biquad_f32_t* narrow,
+    int max_narrow
+)
+{
+    m->wide = wide;
+    m->narrow = narrow;
+    m->max_wide = max_wide;
+    m->max_narrow = max_narrow;
+    m->num_sections = 0;
+    m->num_double = 0;
+}
+
+/**
+ * Number of sections of a filter that would run in double
+ *
+ * @param f Designed filter
+ * @param max_float_radius Largest pole radius run in float
+ * @return Number of double sections
+ */
+int iirdsp_mixed_num_double(const iirdsp_filter_t* f, double max_float_radius)
+{
+    int num_wide = 0;
+
+    for (int i = 0; i < f->num_sections; i++) {
+        num_wide += iirdsp_section_pole_radius(&f->sections[i]) > max_float_radius;
+    }
+    return num_wide;
+}
+
+/**
+ * Build a mixed-precision cascade from a designed filter
+ *
+ * @param m Mixed cascade, attached to storage
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @param max_float_radius Largest pole radius run in float
+ * @return Number of double sections, or -1 if the storage is too small
+ */
+int iirdsp_mixed_init(iirdsp_mixed_t* m, const iirdsp_filter_t* f, double max_float_radius)
+{
+    const int num_wide = iirdsp_mixed_num_double(f, max_float_radius);
+    int wide = 0, narrow = 0;
+
+    if (num_wide > m->max_wide || f->num_sections - num_wide > m->max_narrow) {
+        m->num_sections = 0;
+        m->num_double = 0;
+        return -1;
+    }
+
+    for (int i = 0; i < f->num_sections; i++) {
+        const iirdsp_biquad_t* s = &f->sections[i];
+
+        if (iirdsp_section_pole_radius(s) > max_float_radius) {
+            iirdsp_biquad_f64_t* d = &m->wide[wide++];
+            d->b0 = s->b0;
+            d->b1 = s->b1;
+            d->b2 = s->b2;
+            d->a1 = s->a1;
+            d->a2 = s->a2;
+            m->is_double[i] = 1;
+        } else {
+            iirdsp_biquad_f32_t* d = &m->narrow[narrow++];
+            d->b0 = (float)s->b0;
+            d->b1 = (float)s->b1;
+            d->b2 = (float)s->b2;
+            d->a1 = (float)s->a1;
+            d->a2 = (float)s->a2;
+            m->is_double[i] = 0;
+        }
+    }
+    m->num_sections = f->num_sections;
+    m->num_double = num_wide;
+    iirdsp_mixed_reset(m);
+
+    return num_wide;
+}
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param m Mixed cascade
+ */
+void iirdsp_mixed_reset(iirdsp_mixed_t* m)
+{
+    for (int i = 0; i < m->num_double; i++) {
+        m->wide[i].z1 = 0.0;
+        m->wide[i].z2 = 0.0;
+    }
+    for (int i = 0; i < m->num_sections - m->num_double; i++) {
+        m->narrow[i].z1 = 0.0f;
+        m->narrow[i].z2 = 0.0f;
+    }
+}
+
+/**
+ * Process a single float sample
+ *
+ * Same Direct Form II Transposed recurrence as iirdsp_biquad_process, in
+ * each section's own precision.
+ *
+ * @param m Mixed cascade
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+float iirdsp_mixed_process_sample(iirdsp_mixed_t* m, float x)
+{
+    iirdsp_biquad_f64_t* wide = m->wide;
+    iirdsp_biquad_f32_t* narrow = m->narrow;
+    double u = x;       /* Signal while in double sections */
+    float v = x;        /* Signal while in float sections */
+    int in_double = 0;
+
+    /* Convert only where the precision changes */
+    for (int i = 0; i < m->num_sections; i++) {
+        if (m->is_double[i]) {
+            iirdsp_biquad_f64_t* s = wide++;
+            if (!in_double) {
+                u = v;
+                in_double = 1;
+            }
+            double y = s->b0 * u + s->z1;
+            s->z1 = s->b1 * u - s->a1 * y + s->z2;
+            s->z2 = s->b2 * u - s->a2 * y;
+            u = y;
+        } else {
+            iirdsp_biquad_f32_t* s = narrow++;
+            if (in_double) {
+                v = (float)u;
+                in_double = 0;
+            }
+            float y = s->b0 * v + s->z1;
+            s->z1 = s->b1 * v - s->a1 * y + s->z2;
+            s->z2 = s->b2 * v - s->a2 * y;
+            v = y;
+        }
+    }
+    return in_double ? (float)u : v;
+}
+
+/**
+ * Process a float buffer
+ *
+ * @param m Mixed cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_mixed_process_buffer(iirdsp_mixed_t* m, const float* x, float* y, int N)
+{
+    for (int n = 0; n < N; n++) {
+        y[n] = iirdsp_mixed_process_sample(m, x[n]);
+    }
+}
+
+/* iirdsp_mixed_process_sample for the shared measurement */
+static float mixed_sample(void* ctx, float x)
+{
+    return iirdsp_mixed_process_sample((iirdsp_mixed_t*)ctx, x);
+}
+
+/**
+ * Measure the output error against the designed filter
+ *
+ * @param m Mixed cascade
+ * @param f Designed filter m was built from
+ * @param num_samples Length of the test signal
+ * @return Relative RMS error
+ */
+double iirdsp_mixed_measure_error(iirdsp_mixed_t* m, const iirdsp_filter_t* f, int num_samples)
+{
+    double err;
+
+    iirdsp_mixed_reset(m);
+    err = iirdsp_measure_float_error(f, mixed_sample, m, num_samples);
+    iirdsp_mixed_reset(m);
+
+    return err;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file multi.c
+ * @brief Multichannel cascade implementation
+ *
+ * Frames are processed in chunks small enough to stay in L1; within a
+ * chunk the whole cascade runs section by section in place on the output
+ * buffer. The per-section kernel is written once on the simd.h vector
+ * type (AVX-512, AVX, SSE2, NEON or scalar, whichever the compiler
+ * targets); SVE has its own vector-length agnostic kernel.
+ */
+
+#include "multi.h"
+#include "multi_kernels.h"
+#include "simd.h"
+#include <string.h>
+
+/* Frames per chunk (64 frames x 64 doubles = 32 KiB worst case) */
+#define MULTI_CHUNK_FRAMES 64
+
+/*
+ * Below this many channels the vector kernels have too few lanes to pay
+ * for running the cascade section by section, so each channel runs the
+ * whole cascade per sample, which lets its sections overlap in the CPU.
+ * Fixed-width kernels also need at least one full vector.
+ *
+ * The SVE kernel is used only when CMake built multi_sve.c: a global
+ * -march=...+sve alone defines __ARM_FEATURE_SVE but not the kernel.
+ */
+#if defined(IIRDSP_HAVE_SVE_KERNEL)
+#define MULTI_MIN_VECTOR_CHANNELS 4
+#define MULTI_SECTION iirdsp_multi_section_sve
+#define MULTI_KERNEL_NAME "sve"
+#else
+#define MULTI_MIN_VECTOR_CHANNELS (IIRDSP_VEC_LANES > 4 ? IIRDSP_VEC_LANES : 4)
+/* One DF2T step on a vector of channels */
+static inline iirdsp_vec_t multi_step(
+    iirdsp_vec_t v,
+    iirdsp_vec_t* z1,
+    iirdsp_vec_t* z2,
+    const iirdsp_vec_t* c  /* b0, b1, b2, a1, a2 */
+)
+{
+    iirdsp_vec_t out = iirdsp_vec_fmadd(c[0], v, *z1);
+    iirdsp_vec_t w = iirdsp_vec_fmadd(c[1], v, *z2);
+    *z1 = iirdsp_vec_fnmadd(c[3], out, w);
+    *z2 = iirdsp_vec_fnmadd(c[4], out, iirdsp_vec_mul(c[2], v));
+    return out;
+}
+
+/* Per-lane coefficients of one section for the channels starting at c */
+static inline void multi_load_coeffs(
+    const iirdsp_multi_t* m,
+    int section,
+    int c,
+    iirdsp_vec_t* coef
+)
+{
+    coef[0] = iirdsp_vec_load(&m->b0[section][c]);
+    coef[1] = iirdsp_vec_load(&m->b1[section][c]);
+    coef[2] = iirdsp_vec_load(&m->b2[section][c]);
+    coef[3] = iirdsp_vec_load(&m->a1[section][c]);
+    coef[4] = iirdsp_vec_load(&m->a2[section][c]);
+}
+
+/**
+ * Section kernel on the simd.h vector type
+ *
+ * Each frame costs two dependent multiply-adds per section, so four
+ * vectors of channels are run side by side to keep the pipes busy;
+ * leftover channels go one vector, then one lane, at a time.
+ * Coefficients are loaded per lane, so every channel may differ.
+ */
+static void multi_section_vec(
+    iirdsp_multi_t* m,
+    int section,
+    iirdsp_real* y,
+    int num_frames
+)
+{
+    const int W = IIRDSP_VEC_LANES;
+    const int C = m->num_channels;
+    iirdsp_real* z1 = m->z1[section];
+    iirdsp_real* z2 = m->z2[section];
+    int c = 0;
+
+    for (; c + 4 * W <= C; c += 4 * W) {
+        iirdsp_vec_t coef[4][5], p[4], q[4];
+        for (int k = 0; k < 4; k++) {
+            multi_load_coeffs(m, section, c + k * W, coef[k]);
+            p[k] = iirdsp_vec_load(z1 + c + k * W);
+            q[k] = iirdsp_vec_load(z2 + c + k * W);
+        }
+        for (int n = 0; n < num_frames; n++) {
+            iirdsp_real* row = y + n * C + c;
+            for (int k = 0; k < 4; k++) {
+                iirdsp_vec_t v = iirdsp_vec_load(row + k * W);
+                iirdsp_vec_store(row + k * W, multi_step(v, &p[k], &q[k], coef[k]));
+            }
+        }
+        for (int k = 0; k < 4; k++) {
+            iirdsp_vec_store(z1 + c + k * W, p[k]);
+            iirdsp_vec_store(z2 + c + k * W, q[k]);
+        }
+    }
+
+    for (; c + W <= C; c += W) {
+        iirdsp_vec_t coef[5];
+        iirdsp_vec_t p = iirdsp_vec_load(z1 + c);
+        iirdsp_vec_t q = iirdsp_vec_load(z2 + c);
+        multi_load_coeffs(m, section, c, coef);
+        for (int n = 0; n < num_frames; n++) {
+            iirdsp_real* row = y + n * C + c;
+            iirdsp_vec_store(row, multi_step(iirdsp_vec_load(row), &p, &q, coef));
+        }
+        iirdsp_vec_store(z1 + c, p);
+        iirdsp_vec_store(z2 + c, q);
+    }
+
+    for (; c < C; c++) {
+        const iirdsp_real b0 = m->b0[section][c], b1 = m->b1[section][c], b2 = m->b2[section][c];
+        const iirdsp_real a1 = m->a1[section][c], a2 = m->a2[section][c];
+        iirdsp_real p = z1[c], q = z2[c];
+        for (int n = 0; n < num_frames; n++) {
+            iirdsp_real v = y[n * C + c];
+            iirdsp_real out = b0 * v + p;
+            p = b1 * v - a1 * out + q;
+            q = b2 * v - a2 * out;
+            y[n * C + c] = out;
+        }
+        z1[c] = p;
+        z2[c] = q;
+    }
+}
+
+#define MULTI_SECTION multi_section_vec
+#define MULTI_KERNEL_NAME IIRDSP_VEC_ISA
+#endif
+
+/* Load channel c's design, padding the cascade with identity sections */
+static void multi_set_channel(iirdsp_multi_t* m, int c, const iirdsp_filter_t* f)
+{
+    for (int i = 0; i < IIRDSP_MAX_SECTIONS; i++) {
+        if (i < f->num_sections) {
+            m->b0[i][c] = f->sections[i].b0;
+            m->b1[i][c] = f->sections[i].b1;
+            m->b2[i][c] = f->sections[i].b2;
+            m->a1[i][c] = f->sections[i].a1;
+            m->a2[i][c] = f->sections[i].a2;
+        } else {
+            m->b0[i][c] = 1.0;
+            m->b1[i][c] = 0.0;
+            m->b2[i][c] = 0.0;
+            m->a1[i][c] = 0.0;
+            m->a2[i][c] = 0.0;
+        }
+    }
+}
+
+/**
+ * Initialize a multichannel cascade with one design for all channels
+ *
+ * @param m Multichannel cascade to initialize
+ * @param f Designed filter
+ * @param num_channels Number of channels
+ * @return 0 on success, -1 for an invalid channel count
+ */
+int iirdsp_multi_init(iirdsp_multi_t* m, const iirdsp_filter_t* f, int num_channels)
+{
+    const iirdsp_filter_t* bank[IIRDSP_MULTI_MAX_CHANNELS];
+
+    if (num_channels < 1 || num_channels > IIRDSP_MULTI_MAX_CHANNELS) {
+        return -1;  /* Invalid channel count */
+    }
+    for (int c = 0; c < num_channels; c++) {
+        bank[c] = f;
+    }
+    return iirdsp_multi_init_bank(m, bank, num_channels);
+}
+
+/**
+ * Initialize a multichannel cascade with a design per channel
+ *
+ * @param m Multichannel cascade to initialize
+ * @param filters Array of num_channels designed filters
+ * @param num_channels Number of channels
+ * @return 0 on success, -1 for an invalid channel count
+ */
+int iirdsp_multi_init_bank(
+    iirdsp_multi_t* m,
+    const iirdsp_filter_t* const* filters,
+    int num_channels
+)
+{
+    if (num_channels < 1 || num_channels > IIRDSP_MULTI_MAX_CHANNELS) {
+        return -1;  /* Invalid channel count */
+    }
+
+    m->num_channels = num_channels;
+    m->num_sections = 0;
+    for (int c = 0; c < num_channels; c++) {
+        if (filters[c]->num_sections > m->num_sections) {
+            m->num_sections = filters[c]->num_sections;
+        }
+        multi_set_channel(m, c, filters[c]);
+    }
+    iirdsp_multi_reset(m);
+
+    return 0;
+}
+
+/**
+ * Reset state of all channels
+ *
+ * @param m Multichannel cascade
+ */
+void iirdsp_multi_reset(iirdsp_multi_t* m)
+{
+    memset(m->z1, 0, sizeof(m->z1));
+    memset(m->z2, 0, sizeof(m->z2));
+}
+
+/**
+ * Process interleaved frames
+ *
+ * @param m Multichannel cascade
+ * @param x Interleaved input
+ * @param y Interleaved output
+ * @param num_frames Number of frames
+ */
+void iirdsp_multi_process_interleaved(
+    iirdsp_multi_t* m,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int num_frames
+)
+{
+    const int C = m->num_channels;
+
+    if (C < MULTI_MIN_VECTOR_CHANNELS) {
+        for (int c = 0; c < C; c++) {
+            iirdsp_filter_t f;
+            f.num_sections = m->num_sections;
+            for (int i = 0; i < m->num_sections; i++) {
+                f.sections[i].b0 = m->b0[i][c];
+                f.sections[i].b1 = m->b1[i][c];
+                f.sections[i].b2 = m->b2[i][c];
+                f.sections[i].a1 = m->a1[i][c];
+                f.sections[i].a2 = m->a2[i][c];
+                f.sections[i].z1 = m->z1[i][c];
+                f.sections[i].z2 = m->z2[i][c];
+            }
+            for (int n = 0; n < num_frames; n++) {
+                y[n * C + c] = iirdsp_process_sample(&f, x[n * C + c]);
+            }
+            for (int i = 0; i < m->num_sections; i++) {
+                m->z1[i][c] = f.sections[i].z1;
+                m->z2[i][c] = f.sections[i].z2;
+            }
+        }
+        return;
+    }
+
+    for (int n = 0; n < num_frames; n += MULTI_CHUNK_FRAMES) {
+        int len = (num_frames - n < MULTI_CHUNK_FRAMES) ? num_frames - n : MULTI_CHUNK_FRAMES;
+        iirdsp_real* chunk = y + n * C;
+
+        if (chunk != x + n * C) {
+            memmove(chunk, x + n * C, (size_t)len * C * sizeof(iirdsp_real));
+        }
+        for (int i = 0; i < m->num_sections; i++) {
+            MULTI_SECTION(m, i, chunk, len);
+        }
+    }
+}
+
+/**
+ * Name of the kernel selected at compile time
+ *
+ * @return "sve", "avx512", "avx", "sse2", "neon" or "scalar"
+ */
+const char* iirdsp_multi_kernel_name(void)
+{
+    return MULTI_KERNEL_NAME;
+}
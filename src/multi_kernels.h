@@ -0,0 +1,26 @@
+/**
+ * @file multi_kernels.h
+ * @brief Internal SVE section kernel for the multichannel cascade
+ *
+ * Fixed-width targets share the simd.h kernel in multi.c; SVE vectors
+ * have a run-time length and need predicated loops, so it has its own.
+ * The kernel runs one section of every channel in place over num_frames
+ * interleaved frames, updating the per-channel states.
+ * Not part of the public API.
+ */
+
+#ifndef IIRDSP_MULTI_KERNELS_H
+#define IIRDSP_MULTI_KERNELS_H
+
+#include "multi.h"
+
+#if defined(IIRDSP_HAVE_SVE_KERNEL)
+void iirdsp_multi_section_sve(
+    iirdsp_multi_t* m,
+    int section,
+    iirdsp_real* y,
+    int num_frames
+);
+#endif
+
+#endif /* IIRDSP_MULTI_KERNELS_H */
@@ -0,0 +1,111 @@
+/**
+ * @file multi_sve.c
+ * @brief AArch64 SVE section kernel for the multichannel cascade
+ *
+ * Vector-length agnostic: channels are covered by predicated vectors of
+ * whatever width the hardware has, so the channel tail needs no scalar
+ * loop. Two vectors are run side by side to hide multiply-add latency;
+ * the second one's predicate is simply empty when there is nothing left.
+ * Built only when the compiler targets SVE (IIRDSP_ENABLE_SVE).
+ */
+
+#if defined(__ARM_FEATURE_SVE)
+
+#include <arm_sve.h>
+#include "multi_kernels.h"
+
+#ifdef IIRDSP_USE_FLOAT
+typedef svfloat32_t vreal_t;
+#define VCOUNT()           ((int)svcntw())
+#define VWHILE(i, n)       svwhilelt_b32_s32((i), (n))
+#define VLD(pg, p)         svld1_f32((pg), (p))
+#define VST(pg, p, v)      svst1_f32((pg), (p), (v))
+#define VMUL(pg, a, k)     svmul_f32_x((pg), (a), (k))
+#define VFMA(pg, acc, a, k) svmla_f32_x((pg), (acc), (a), (k))  /* acc + a * k */
+#define VFMS(pg, acc, a, k) svmls_f32_x((pg), (acc), (a), (k))  /* acc - a * k */
+#else
+typedef svfloat64_t vreal_t;
+#define VCOUNT()           ((int)svcntd())
+#define VWHILE(i, n)       svwhilelt_b64_s32((i), (n))
+#define VLD(pg, p)         svld1_f64((pg), (p))
+#define VST(pg, p, v)      svst1_f64((pg), (p), (v))
+#define VMUL(pg, a, k)     svmul_f64_x((pg), (a), (k))
+#define VFMA(pg, acc, a, k) svmla_f64_x((pg), (acc), (a), (k))
+#define VFMS(pg, acc, a, k) svmls_f64_x((pg), (acc), (a), (k))
+#endif
+
+/* Per-lane coefficients of one section */
+typedef struct {
+    vreal_t b0, b1, b2, a1, a2;
+} sve_coeffs_t;
+
+static inline sve_coeffs_t sve_load_coeffs(
+    svbool_t pg,
+    const iirdsp_multi_t* m,
+    int section,
+    int c
+)
+{
+    sve_coeffs_t k;
+    k.b0 = VLD(pg, &m->b0[section][c]);
+    k.b1 = VLD(pg, &m->b1[section][c]);
+    k.b2 = VLD(pg, &m->b2[section][c]);
+    k.a1 = VLD(pg, &m->a1[section][c]);
+    k.a2 = VLD(pg, &m->a2[section][c]);
+    return k;
+}
+
+/* One DF2T step on a predicated vector of channels */
+#define SVE_BIQUAD_STEP(pg, k, v, z1, z2)                   \
+    do {                                                    \
+        vreal_t out_ = VFMA((pg), (z1), (v), (k).b0);       \
+        vreal_t w_ = VFMA((pg), (z2), (v), (k).b1);         \
+        (z1) = VFMS((pg), w_, out_, (k).a1);                \
+        (z2) = VFMS((pg), VMUL((pg), (v), (k).b2), out_, (k).a2); \
+        (v) = out_;                                         \
+    } while (0)
+
+/**
+ * Run one section in place over interleaved frames
+ *
+ * @param m Multichannel cascade (coefficients and state)
+ * @param section Section index
+ * @param y Interleaved samples (num_frames * num_channels), in place
+ * @param num_frames Number of frames
+ */
+void iirdsp_multi_section_sve(
+    iirdsp_multi_t* m,
+    int section,
+    iirdsp_real* y,
+    int num_frames
+)
+{
+    iirdsp_real* z1 = m->z1[section];
+    iirdsp_real* z2 = m->z2[section];
+    const int C = m->num_channels;
+    const int W = VCOUNT();
+
+    for (int c = 0; c < C; c += 2 * W) {
+        const svbool_t pg0 = VWHILE(c, C);
+        const svbool_t pg1 = VWHILE(c + W, C);
+        vreal_t p0 = VLD(pg0, z1 + c), q0 = VLD(pg0, z2 + c);
+        vreal_t p1 = VLD(pg1, z1 + c + W), q1 = VLD(pg1, z2 + c + W);
+        const sve_coeffs_t k0 = sve_load_coeffs(pg0, m, section, c);
+        const sve_coeffs_t k1 = sve_load_coeffs(pg1, m, section, c + W);
+
+        for (int n = 0; n < num_frames; n++) {
+            iirdsp_real* row = y + n * C + c;
+            vreal_t v0 = VLD(pg0, row);
+            vreal_t v1 = VLD(pg1, row + W);
+            SVE_BIQUAD_STEP(pg0, k0, v0, p0, q0);
+            SVE_BIQUAD_STEP(pg1, k1, v1, p1, q1);
+            VST(pg0, row, v0);
+            VST(pg1, row + W, v1);
+        }
+
+        VST(pg0, z1 + c, p0); VST(pg0, z2 + c, q0);
+        VST(pg1, z1 + c + W, p1); VST(pg1, z2 + c + W, q1);
+    }
+}
+
+#endif /* __ARM_FEATURE_SVE */
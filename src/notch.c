@@ -5,6 +5,7 @@
 
 #include "notch.h"
 #include <math.h>
+#include <string.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -65,4 +66,287 @@ int notch_filter_init(
     f->sections[0].z2 = 0.0;
 
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * Design notches at a fundamental and its harmonics as one cascade
+ *
+ * @param f Filter structure to initialize
+ * @param f0_hz Fundamental frequency (Hz)
+ * @param num_harmonics Number of notches
+ * @param Q Quality factor of every notch
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int notch_comb_init(
+    iirdsp_filter_t* f,
+    iirdsp_real f0_hz,
+    int num_harmonics,
+    iirdsp_real Q,
+    iirdsp_real fs_hz
+)
+{
+    iirdsp_filter_t single;
+
+    if (num_harmonics < 1 || num_harmonics > IIRDSP_MAX_SECTIONS) {
+        return -1;  /* Invalid number of harmonics */
+    }
+
+    for (int k = 0; k < num_harmonics; k++) {
+        int ret = notch_filter_init(&single, (k + 1) * f0_hz, Q, fs_hz);
+        if (ret != 0) {
+            return ret;
+        }
+        f->sections[k] = single.sections[0];
+    }
+    f->num_sections = num_harmonics;
+
+    return 0;
+}
+
+/**
+ * Design an IIR comb notch
+ *
+ * Follows scipy.signal.iircomb (Orfanidis, Introduction to Signal
+ * Processing, eqs. 11.5.1-11.5.4) with G0 = 1, G = 0, GB = 1/sqrt(2):
+ *   beta = tan(N * w_delta / 4),  w_delta = 2 pi f0 / (fs Q)
+ *   b = 1 / (1 + beta),  a = (1 - beta) / (1 + beta)
+ *
+ * @param c Comb to initialize
+ * @param f0_hz Comb spacing (Hz)
+ * @param Q Quality factor
+ * @param fs_hz Sampling frequency (Hz)
+ * @param pass_zero Null placement (see notch.h)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_comb_init(
+    iirdsp_comb_t* c,
+    iirdsp_real f0_hz,
+    iirdsp_real Q,
+    iirdsp_real fs_hz,
+    int pass_zero
+)
+{
+    if (Q <= 0.0 || f0_hz <= 0.0 || fs_hz <= 0.0) {
+        return -1;  /* Invalid parameters */
+    }
+
+    iirdsp_real ratio = fs_hz / f0_hz;
+    int N = (int)floor(ratio + 0.5);
+    if (N < 2 || N > IIRDSP_COMB_MAX_DELAY || fabs(ratio - N) > 1e-6 * ratio) {
+        return -2;  /* Delay must be a whole number of samples */
+    }
+
+    iirdsp_real w_delta = 2.0 * M_PI * f0_hz / fs_hz / Q;
+    iirdsp_real beta = tan(N * w_delta / 4.0);
+
+    c->b = 1.0 / (1.0 + beta);
+    c->a = (1.0 - beta) / (1.0 + beta);
+    c->sign = pass_zero ? 1.0 : -1.0;
+    c->N = N;
+    iirdsp_comb_reset(c);
+
+    return 0;
+}
+
+/**
+ * Reset the delay line
+ *
+ * @param c Comb
+ */
+void iirdsp_comb_reset(iirdsp_comb_t* c)
+{
+    memset(c->w, 0, sizeof(c->w));
+    c->pos = 0;
+}
+
+/**
+ * Filter one sample
+ *
+ * Direct form II over the delay line:
+ *   w[n] = x[n] - sign * a * w[n-N],  y[n] = b * (w[n] + sign * w[n-N])
+ *
+ * @param c Comb
+ * @param x Input sample
+ * @return Output sample
+ */
+iirdsp_real iirdsp_comb_process_sample(iirdsp_comb_t* c, iirdsp_real x)
+{
+    iirdsp_real wN = c->w[c->pos];
+    iirdsp_real w = x - (c->sign * c->a) * wN;
+
+    c->w[c->pos] = w;
+    if (++c->pos == c->N) {
+        c->pos = 0;
+    }
+    return c->b * w + (c->sign * c->b) * wN;
+}
+
+/**
+ * Filter a buffer
+ *
+ * Runs up to the end of the delay line at a time: within such a run
+ * every w[n-N] is already in the line, so iterations are independent.
+ *
+ * @param c Comb
+ * @param x Input signal
+ * @param y Output signal
+ * @param N Number of samples
+ */
+void iirdsp_comb_process_buffer(
+    iirdsp_comb_t* c,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+)
+{
+    const iirdsp_real b = c->b;
+    const iirdsp_real sa = c->sign * c->a;
+    const iirdsp_real sb = c->sign * c->b;
+    int n = 0;
+
+    while (n < N) {
+        int len = c->N - c->pos;
+        if (len > N - n) {
+            len = N - n;
+        }
+
+        iirdsp_real* line = c->w + c->pos;
+        for (int i = 0; i < len; i++) {
+            iirdsp_real wN = line[i];
+            iirdsp_real w = x[n + i] - sa * wN;
+            line[i] = w;
+            y[n + i] = b * w + sb * wN;
+        }
+
+        c->pos += len;
+        if (c->pos == c->N) {
+            c->pos = 0;
+        }
+        n += len;
+    }
+}
+
+/* Smoothing factor of the regressor power estimate used to normalize mu */
+#define ADAPTIVE_NOTCH_POWER_ALPHA 0.01
+
+/* Floor on the power estimate so silence does not blow up the step */
+#define ADAPTIVE_NOTCH_POWER_FLOOR 1e-12
+
+/**
+ * Initialize an adaptive notch
+ *
+ * @param n Adaptive notch to initialize
+ * @param f0_hz Initial notch frequency (Hz)
+ * @param Q Quality factor
+ * @param f_min_hz Lowest trackable frequency (Hz)
+ * @param f_max_hz Highest trackable frequency (Hz)
+ * @param mu Adaptation step size
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_adaptive_notch_init(
+    iirdsp_adaptive_notch_t* n,
+    iirdsp_real f0_hz,
+    iirdsp_real Q,
+    iirdsp_real f_min_hz,
+    iirdsp_real f_max_hz,
+    iirdsp_real mu,
+    iirdsp_real fs_hz
+)
+{
+    if (Q <= 0.0 || fs_hz <= 0.0 || mu < 0.0) {
+        return -1;  /* Invalid parameters */
+    }
+    if (f_min_hz <= 0.0 || f_max_hz >= fs_hz / 2.0 ||
+        f0_hz < f_min_hz || f0_hz > f_max_hz) {
+        return -2;  /* Frequency range outside (0, Nyquist) or missing f0 */
+    }
+
+    /* Same bandwidth term as notch_filter_init at f0 */
+    iirdsp_real w0 = 2.0 * M_PI * f0_hz / fs_hz;
+    iirdsp_real alpha = sin(w0) / (2.0 * Q);
+
+    n->k = (1.0 - alpha) / (1.0 + alpha);
+    n->g = 1.0 / (1.0 + alpha);
+    n->c = cos(w0);
+    n->c_min = cos(2.0 * M_PI * f_max_hz / fs_hz);
+    n->c_max = cos(2.0 * M_PI * f_min_hz / fs_hz);
+    n->mu = mu;
+    n->fs_hz = fs_hz;
+    iirdsp_adaptive_notch_reset(n);
+
+    return 0;
+}
+
+/**
+ * Reset state, keeping the current frequency estimate
+ *
+ * @param n Adaptive notch
+ */
+void iirdsp_adaptive_notch_reset(iirdsp_adaptive_notch_t* n)
+{
+    n->s1 = 0.0;
+    n->s2 = 0.0;
+    n->power = 0.0;
+}
+
+/**
+ * Filter one sample and adapt the notch frequency
+ *
+ * @param n Adaptive notch
+ * @param x Input sample
+ * @return Output sample
+ */
+iirdsp_real iirdsp_adaptive_notch_process_sample(iirdsp_adaptive_notch_t* n, iirdsp_real x)
+{
+    const iirdsp_real s1 = n->s1, s2 = n->s2;
+    iirdsp_real s0 = x + (1.0 + n->k) * n->c * s1 - n->k * s2;
+    iirdsp_real e = n->g * (s0 - 2.0 * n->c * s1 + s2);
+
+    /* Normalized LMS step along -de/dc (FIR part) = 2g s[n-1] */
+    n->power += ADAPTIVE_NOTCH_POWER_ALPHA * (s1 * s1 - n->power);
+    iirdsp_real c = n->c + n->mu * e * s1 / (n->power + ADAPTIVE_NOTCH_POWER_FLOOR);
+    if (c < n->c_min) {
+        c = n->c_min;
+    }
+    if (c > n->c_max) {
+        c = n->c_max;
+    }
+    n->c = c;
+
+    n->s2 = s1;
+    n->s1 = s0;
+    return e;
+}
+
+/**
+ * Filter a buffer and adapt the notch frequency
+ *
+ * @param n Adaptive notch
+ * @param x Input signal
+ * @param y Output signal
+ * @param N Number of samples
+ */
+void iirdsp_adaptive_notch_process_buffer(
+    iirdsp_adaptive_notch_t* n,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+)
+{
+    for (int i = 0; i < N; i++) {
+        y[i] = iirdsp_adaptive_notch_process_sample(n, x[i]);
+    }
+}
+
+/**
+ * Current notch frequency estimate
+ *
+ * @param n Adaptive notch
+ * @return Frequency (Hz)
+ */
+iirdsp_real iirdsp_adaptive_notch_frequency(const iirdsp_adaptive_notch_t* n)
+{
+    return acos(n->c) * n->fs_hz / (2.0 * M_PI);
+}
@@ -0,0 +1,318 @@
+/**
+ * @file parallel.c
+ * @brief Parallel-form realization implementation
+ *
+ * The expansion is done on the poles p_k of the whole cascade, written in
+ * w = z^-1:
+ *
+ *   H(w) = B(w) / prod_k (1 - p_k w) = direct + sum_k r_k / (1 - p_k w)
+ *   r_k  = B(1/p_k) / prod_{j != k} (1 - p_j / p_k)
+ *   direct = H(w -> inf)
+ *
+ * The two first-order terms of a section's poles are then recombined into
+ * one real second-order term.
+ */
+
+#include "parallel.h"
+#include "response.h"
+#include "simd.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define PARALLEL_MAX_POLES (2 * IIRDSP_MAX_SECTIONS)
+#define PARALLEL_MAX_VECS (IIRDSP_MAX_SECTIONS / IIRDSP_VEC_LANES)
+
+/* (re, im) *= (b_re, b_im) */
+static void cmul(double* re, double* im, double b_re, double b_im)
+{
+    double t = *re * b_re - *im * b_im;
+    *im = *re * b_im + *im * b_re;
+    *re = t;
+}
+
+/* (re, im) /= (b_re, b_im) */
+static void cdiv(double* re, double* im, double b_re, double b_im)
+{
+    double d = b_re * b_re + b_im * b_im;
+    double t = (*re * b_re + *im * b_im) / d;
+    *im = (*im * b_re - *re * b_im) / d;
+    *re = t;
+}
+
+/**
+ * Poles of a section in w-form: roots p of z^2 + a1 z + a2 (z + a1 if
+ * a2 == 0)
+ *
+ * @return Number of poles (0, 1 or 2)
+ */
+static int section_poles(const iirdsp_biquad_t* s, double* re, double* im)
+{
+    const double a1 = s->a1;
+    const double a2 = s->a2;
+
+    if (a2 == 0.0) {
+        if (a1 == 0.0) {
+            return 0;
+        }
+        re[0] = -a1;
+        im[0] = 0.0;
+        return 1;
+    }
+
+    const double disc = a1 * a1 - 4.0 * a2;
+    if (disc < 0.0) {
+        re[0] = re[1] = -a1 / 2.0;
+        im[0] = sqrt(-disc) / 2.0;
+        im[1] = -im[0];
+    } else {
+        double q = -0.5 * (a1 + copysign(sqrt(disc), a1));
+        re[0] = q;
+        re[1] = a2 / q;
+        im[0] = im[1] = 0.0;
+    }
+    return 2;
+}
+
+/**
+ * Convert a designed cascade to parallel form
+ *
+ * @param p Parallel form to initialize
+ * @param f Designed filter (coefficients only, state is ignored)
+ * @return 0 on success, -1 if a section is improper, -2 on repeated poles
+ */
+int iirdsp_parallel_init(iirdsp_parallel_t* p, const iirdsp_filter_t* f)
+{
+    double pole_re[PARALLEL_MAX_POLES], pole_im[PARALLEL_MAX_POLES];
+    double res_re[PARALLEL_MAX_POLES], res_im[PARALLEL_MAX_POLES];
+    int first[IIRDSP_MAX_SECTIONS], count[IIRDSP_MAX_SECTIONS];
+    int num_poles = 0;
+    double direct = 1.0;
+
+    /* Collect poles and the direct term H(w -> inf), section by section */
+    for (int i = 0; i < f->num_sections; i++) {
+        const iirdsp_biquad_t* s = &f->sections[i];
+
+        first[i] = num_poles;
+        count[i] = section_poles(s, &pole_re[num_poles], &pole_im[num_poles]);
+        num_poles += count[i];
+
+        if (count[i] == 2) {
+            direct *= s->b2 / s->a2;
+        } else if (count[i] == 1 && s->b2 == 0.0) {
+            direct *= s->b1 / s->a1;
+        } else if (count[i] == 0 && s->b1 == 0.0 && s->b2 == 0.0) {
+            direct *= s->b0;
+        } else {
+            return -1;  /* Numerator degree above denominator degree */
+        }
+    }
+
+    /* Residues */
+    for (int k = 0; k < num_poles; k++) {
+        double w_re = 1.0, w_im = 0.0;  /* w = 1 / p_k */
+        double num_re = 1.0, num_im = 0.0;
+        double den_re = 1.0, den_im = 0.0;
+
+        cdiv(&w_re, &w_im, pole_re[k], pole_im[k]);
+        for (int i = 0; i < f->num_sections; i++) {
+            const iirdsp_biquad_t* s = &f->sections[i];
+            /* B_i(w) = (b2 w + b1) w + b0 */
+            double b_re = s->b2 * w_re + s->b1, b_im = s->b2 * w_im;
+            cmul(&b_re, &b_im, w_re, w_im);
+            cmul(&num_re, &num_im, b_re + s->b0, b_im);
+        }
+        for (int j = 0; j < num_poles; j++) {
+            if (j != k) {
+                /* 1 - p_j / p_k = 1 - p_j w */
+                double t_re = pole_re[j], t_im = pole_im[j];
+                cmul(&t_re, &t_im, w_re, w_im);
+                cmul(&den_re, &den_im, 1.0 - t_re, -t_im);
+            }
+        }
+        if (hypot(den_re, den_im) < 1e-12) {
+            return -2;  /* Repeated pole: no simple partial fraction */
+        }
+        cdiv(&num_re, &num_im, den_re, den_im);
+        res_re[k] = num_re;
+        res_im[k] = num_im;
+    }
+
+    /* Recombine each section's pole pair into one real section */
+    for (int i = 0; i < IIRDSP_MAX_SECTIONS; i++) {
+        double g0 = 0.0, g1 = 0.0, a1 = 0.0, a2 = 0.0;
+
+        if (i < f->num_sections) {
+            const int k = first[i];
+            a1 = f->sections[i].a1;
+            a2 = f->sections[i].a2;
+            if (count[i] == 1) {
+                g0 = res_re[k];
+            } else if (count[i] == 2 && pole_im[k] != 0.0) {
+                /* r/(1-pw) + conj: (2 Re r - 2 Re(r conj(p)) w) / A(w) */
+                g0 = 2.0 * res_re[k];
+                g1 = -2.0 * (res_re[k] * pole_re[k] + res_im[k] * pole_im[k]);
+            } else if (count[i] == 2) {
+                g0 = res_re[k] + res_re[k + 1];
+                g1 = -(res_re[k] * pole_re[k + 1] + res_re[k + 1] * pole_re[k]);
+            }
+        }
+        p->g0[i] = g0;
+        p->g1[i] = g1;
+        p->a1[i] = a1;
+        p->a2[i] = a2;
+    }
+    p->direct = direct;
+    p->num_sections = f->num_sections;
+    iirdsp_parallel_reset(p);
+
+    return 0;
+}
+
+/**
+ * Reset state (zero all history)
+ *
+ * @param p Parallel form
+ */
+void iirdsp_parallel_reset(iirdsp_parallel_t* p)
+{
+    for (int i = 0; i < IIRDSP_MAX_SECTIONS; i++) {
+        p->z1[i] = 0.0;
+        p->z2[i] = 0.0;
+    }
+}
+
+/**
+ * Process a single sample
+ *
+ * Sections are summed per vector lane, in the order of the buffer path,
+ * so both paths give identical output.
+ *
+ * @param p Parallel form
+ * @param x Input sample
+ * @return Filtered output sample
+ */
+iirdsp_real iirdsp_parallel_process_sample(iirdsp_parallel_t* p, iirdsp_real x)
+{
+    iirdsp_real lanes[IIRDSP_VEC_LANES];
+    iirdsp_real sum = 0.0;
+
+    for (int l = 0; l < IIRDSP_VEC_LANES; l++) {
+        lanes[l] = 0.0;
+    }
+    for (int i = 0; i < p->num_sections; i++) {
+        /* DF2T with b2 = 0 */
+        const iirdsp_real out = iirdsp_fmadd(p->g0[i], x, p->z1[i]);
+        p->z1[i] = iirdsp_fnmadd(p->a1[i], out, iirdsp_fmadd(p->g1[i], x, p->z2[i]));
+        p->z2[i] = iirdsp_fnmadd(p->a2[i], out, 0.0);
+        lanes[i % IIRDSP_VEC_LANES] += out;
+    }
+    for (int l = 0; l < IIRDSP_VEC_LANES; l++) {
+        sum += lanes[l];
+    }
+    return iirdsp_fmadd(p->direct, x, sum);
+}
+
+/**
+ * Process a buffer of samples
+ *
+ * Only the vectors that hold sections are run; unused lanes in the last
+ * one carry zero sections. The per-sample critical path is one section.
+ *
+ * @param p Parallel form
+ * @param x Input signal (length N)
+ * @param y Output signal (length N), may alias x
+ * @param N Number of samples
+ */
+void iirdsp_parallel_process_buffer(
+    iirdsp_parallel_t* p,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+)
+{
+    iirdsp_vec_t g0[PARALLEL_MAX_VECS], g1[PARALLEL_MAX_VECS];
+    iirdsp_vec_t a1[PARALLEL_MAX_VECS], a2[PARALLEL_MAX_VECS];
+    iirdsp_vec_t z1[PARALLEL_MAX_VECS], z2[PARALLEL_MAX_VECS];
+    iirdsp_real lanes[IIRDSP_VEC_LANES];
+    const iirdsp_real direct = p->direct;
+    const int num_vecs = (p->num_sections + IIRDSP_VEC_LANES - 1) / IIRDSP_VEC_LANES;
+
+    /* Load every vector so none is left uninitialized; only num_vecs run */
+    for (int v = 0; v < PARALLEL_MAX_VECS; v++) {
+        g0[v] = iirdsp_vec_load(&p->g0[v * IIRDSP_VEC_LANES]);
+        g1[v] = iirdsp_vec_load(&p->g1[v * IIRDSP_VEC_LANES]);
+        a1[v] = iirdsp_vec_load(&p->a1[v * IIRDSP_VEC_LANES]);
+        a2[v] = iirdsp_vec_load(&p->a2[v * IIRDSP_VEC_LANES]);
+        z1[v] = iirdsp_vec_load(&p->z1[v * IIRDSP_VEC_LANES]);
+        z2[v] = iirdsp_vec_load(&p->z2[v * IIRDSP_VEC_LANES]);
+    }
+
+    for (int n = 0; n < N; n++) {
+        const iirdsp_real xn = x[n];
+        const iirdsp_vec_t xv = iirdsp_vec_set1(xn);
+        iirdsp_vec_t acc = iirdsp_vec_zero();
+        iirdsp_real sum = 0.0;
+
+        for (int v = 0; v < num_vecs; v++) {
+            /* DF2T with b2 = 0 */
+            iirdsp_vec_t out = iirdsp_vec_fmadd(g0[v], xv, z1[v]);
+            z1[v] = iirdsp_vec_fnmadd(a1[v], out, iirdsp_vec_fmadd(g1[v], xv, z2[v]));
+            z2[v] = iirdsp_vec_fnmadd(a2[v], out, iirdsp_vec_zero());
+            acc = iirdsp_vec_add(acc, out);
+        }
+        iirdsp_vec_store(lanes, acc);
+        for (int l = 0; l < IIRDSP_VEC_LANES; l++) {
+            sum += lanes[l];
+        }
+        y[n] = iirdsp_fmadd(direct, xn, sum);
+    }
+
+    for (int v = 0; v < num_vecs; v++) {
+        iirdsp_vec_store(&p->z1[v * IIRDSP_VEC_LANES], z1[v]);
+        iirdsp_vec_store(&p->z2[v * IIRDSP_VEC_LANES], z2[v]);
+    }
+}
+
+/**
+ * Accuracy of the parallel form against the cascade it came from
+ *
+ * @param p Parallel form
+ * @param f Cascade p was built from
+ * @param num_freqs Number of frequency points (>= 2)
+ * @return Relative peak deviation
+ */
+iirdsp_real iirdsp_parallel_response_error(
+    const iirdsp_parallel_t* p,
+    const iirdsp_filter_t* f,
+    int num_freqs
+)
+{
+    double err = 0.0, peak = 0.0;
+
+    for (int n = 0; n < num_freqs; n++) {
+        iirdsp_real freq = 0.5 * n / (num_freqs - 1);
+        iirdsp_real mag, phase;
+        const double w = 2.0 * M_PI * freq;
+        double h_re = p->direct, h_im = 0.0;
+
+        iirdsp_sosfreqz(f, &freq, 1, 1.0, &mag, &phase, NULL);
+
+        for (int i = 0; i < p->num_sections; i++) {
+            /* (g0 + g1 e^-jw) / (1 + a1 e^-jw + a2 e^-2jw) */
+            double n_re = p->g0[i] + p->g1[i] * cos(w), n_im = -p->g1[i] * sin(w);
+            double d_re = 1.0 + p->a1[i] * cos(w) + p->a2[i] * cos(2.0 * w);
+            double d_im = -p->a1[i] * sin(w) - p->a2[i] * sin(2.0 * w);
+            cdiv(&n_re, &n_im, d_re, d_im);
+            h_re += n_re;
+            h_im += n_im;
+        }
+
+        err = fmax(err, hypot(h_re - mag * cos(phase), h_im - mag * sin(phase)));
+        peak = fmax(peak, mag);
+    }
+    return (peak > 0.0) ? err / peak : err;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file qrs.c
+ * @brief Streaming QRS detector implementation
+ */
+
+#include "qrs.h"
+#include "butter.h"
+#include "response.h"
+
+/**
+ * Initialize a detector
+ *
+ * @param q Detector to initialize
+ * @param fs_hz Sampling frequency (Hz)
+ * @return 0 on success, -2 for an unsupported sampling frequency
+ */
+int iirdsp_qrs_init(iirdsp_qrs_t* q, iirdsp_real fs_hz)
+{
+    const iirdsp_real f_center = 10.0;
+    iirdsp_real gd;
+
+    if (!(fs_hz >= 50.0) || (int)(0.15 * fs_hz + 0.5) > IIRDSP_QRS_MAX_WINDOW) {
+        return -2;
+    }
+    if (butter_bandpass_init(&q->bandpass, 2, 5.0, 15.0, fs_hz) != 0) {
+        return -2;
+    }
+
+    q->fs = fs_hz;
+    q->window_len = (int)(0.15 * fs_hz + 0.5);
+    q->learn_len = (int)(2.0 * fs_hz + 0.5);
+    q->refractory = (int)(0.2 * fs_hz + 0.5);
+    q->t_wave_window = (int)(0.36 * fs_hz + 0.5);
+
+    /* Band-pass at the QRS center, derivative, half the integrator */
+    iirdsp_group_delay(&q->bandpass, &f_center, 1, fs_hz, &gd);
+    q->delay = (int)(gd + 0.5) + 2 + (q->window_len - 1) / 2;
+
+    iirdsp_qrs_reset(q);
+    return 0;
+}
+
+/**
+ * Reset state (restarts the learning phase and the sample count)
+ *
+ * @param q Detector
+ */
+void iirdsp_qrs_reset(iirdsp_qrs_t* q)
+{
+    iirdsp_filter_reset(&q->bandpass);
+    for (int k = 0; k < 4; k++) {
+        q->bp_hist[k] = 0.0;
+    }
+    for (int k = 0; k < IIRDSP_QRS_MAX_WINDOW; k++) {
+        q->window[k] = 0.0;
+    }
+    q->window_sum = 0.0;
+    q->window_pos = 0;
+
+    q->prev_mwi = 0.0;
+    q->peak = 0.0;
+    q->peak_slope = 0.0;
+    q->peak_index = 0;
+
+    q->spki = 0.0;
+    q->npki = 0.0;
+    q->last_qrs_slope = 0.0;
+
+    q->backup_peak = 0.0;
+    q->backup_slope = 0.0;
+    q->backup_index = 0;
+
+    for (int k = 0; k < IIRDSP_QRS_RR_HISTORY; k++) {
+        q->rr[k] = 0;
+    }
+    q->rr_count = 0;
+    q->rr_mean = 0;
+
+    q->last_qrs = -1;
+    q->n = 0;
+}
+
+/* Accept a peak of the integral as a beat; weight is the SPKI update rate */
+static long accept_beat(iirdsp_qrs_t* q, iirdsp_real peak, iirdsp_real slope, long index, iirdsp_real weight)
+{
+    if (q->last_qrs >= 0) {
+        long sum = 0;
+
+        q->rr[q->rr_count % IIRDSP_QRS_RR_HISTORY] = (int)(index - q->last_qrs);
+        q->rr_count++;
+        for (int k = 0; k < IIRDSP_QRS_RR_HISTORY && k < q->rr_count; k++) {
+            sum += q->rr[k];
+        }
+        q->rr_mean = (int)(sum / (q->rr_count < IIRDSP_QRS_RR_HISTORY ? q->rr_count : IIRDSP_QRS_RR_HISTORY));
+    }
+
+    q->spki = weight * peak + (1.0 - weight) * q->spki;
+    q->last_qrs = index;
+    q->last_qrs_slope = slope;
+    q->backup_peak = 0.0;
+
+    return index - q->delay;
+}
+
+/* Classify a completed peak of the integral; returns 1 for a beat */
+static int classify_peak(iirdsp_qrs_t* q, iirdsp_real peak, iirdsp_real slope, long index, long* r_index)
+{
+    const iirdsp_real threshold = q->npki + 0.25 * (q->spki - q->npki);
+    const long since = (q->last_qrs >= 0) ? index - q->last_qrs : index + q->t_wave_window;
+
+    if (since < q->refractory) {
+        return 0;
+    }
+    if (peak > threshold && !(since < q->t_wave_window && slope < 0.5 * q->last_qrs_slope)) {
+        *r_index = accept_beat(q, peak, slope, index, 0.125);
+        return 1;
+    }
+
+    q->npki = 0.125 * peak + 0.875 * q->npki;
+    if (peak < threshold && peak > q->backup_peak) {
+        q->backup_peak = peak;
+        q->backup_slope = slope;
+        q->backup_index = index;
+    }
+    return 0;
+}
+
+/**
+ * Process a single sample
+ *
+ * @param q Detector
+ * @param x Input sample
+ * @param r_index Receives the input index of the R peak when a beat is
+ *        reported
+ * @return 1 if a beat is reported, 0 otherwise
+ */
+int iirdsp_qrs_process_sample(iirdsp_qrs_t* q, iirdsp_real x, long* r_index)
+{
+    const long index = q->n++;
+    iirdsp_real bp, d, sq, mwi;
+    int beat = 0;
+
+    /* Band-pass (no start-up transient from a DC offset) */
+    if (index == 0) {
+        iirdsp_filter_init_steady(&q->bandpass, x);
+    }
+    bp = iirdsp_process_sample(&q->bandpass, x);
+
+    /* Five-point derivative, centered two samples back */
+    d = (2.0 * bp + q->bp_hist[0] - q->bp_hist[2] - 2.0 * q->bp_hist[3]) * (q->fs / 8.0);
+    q->bp_hist[3] = q->bp_hist[2];
+    q->bp_hist[2] = q->bp_hist[1];
+    q->bp_hist[1] = q->bp_hist[0];
+    q->bp_hist[0] = bp;
+
+    /* Squaring and moving-window integral; the running sum is recomputed
+     * once per window so rounding does not accumulate */
+    sq = d * d;
+    q->window_sum += sq - q->window[q->window_pos];
+    q->window[q->window_pos] = sq;
+    if (++q->window_pos == q->window_len) {
+        q->window_pos = 0;
+        q->window_sum = 0.0;
+        for (int k = 0; k < q->window_len; k++) {
+            q->window_sum += q->window[k];
+        }
+    }
+    mwi = q->window_sum / q->window_len;
+
+    /* Learning phase: SPKI from the largest value, NPKI from the mean */
+    if (index < q->learn_len) {
+        q->spki = (mwi > q->spki) ? mwi : q->spki;
+        q->npki += mwi;
+        if (index == q->learn_len - 1) {
+            q->spki *= 0.33;
+            q->npki *= 0.5 / q->learn_len;
+        }
+        q->prev_mwi = mwi;
+        return 0;
+    }
+
+    /* Track a rising hump; it is a peak once it falls to half its height */
+    if (q->peak > 0.0 || mwi > q->prev_mwi) {
+        if (mwi > q->peak) {
+            q->peak = mwi;
+            q->peak_index = index;
+        }
+        q->peak_slope = (sq > q->peak_slope) ? sq : q->peak_slope;
+    }
+    if (q->peak > 0.0 && mwi < 0.5 * q->peak) {
+        beat = classify_peak(q, q->peak, q->peak_slope, q->peak_index, r_index);
+        q->peak = 0.0;
+        q->peak_slope = 0.0;
+    }
+    q->prev_mwi = mwi;
+
+    /* Search-back: nothing for 1.66 mean RR, take the best peak above half
+     * the threshold */
+    if (!beat && q->rr_mean > 0 && q->backup_peak > 0.0 &&
+        index - q->last_qrs > (long)(1.66 * q->rr_mean)) {
+        const iirdsp_real threshold = q->npki + 0.25 * (q->spki - q->npki);
+
+        if (q->backup_peak > 0.5 * threshold) {
+            *r_index = accept_beat(q, q->backup_peak, q->backup_slope, q->backup_index, 0.25);
+            beat = 1;
+        }
+    }
+
+    return beat;
+}
+
+/**
+ * Process a buffer (streaming)
+ *
+ * @param q Detector
+ * @param x Input signal (length N)
+ * @param N Number of samples
+ * @param r_index Receives the R peak indices of reported beats
+ * @param max_beats Capacity of r_index
+ * @return Number of indices stored in r_index
+ */
+int iirdsp_qrs_process_buffer(
+    iirdsp_qrs_t* q,
+    const iirdsp_real* x,
+    int N,
+    long* r_index,
+    int max_beats
+)
+{
+    int count = 0;
+    long r;
+
+    for (int n = 0; n < N; n++) {
+        if (iirdsp_qrs_process_sample(q, x[n], &r) && count < max_beats) {
+            r_index[count++] = r;
+        }
+    }
+    return count;
+}
+
+/**
+ * Heart rate from the mean of the recent RR intervals
+ *
+ * @param q Detector
+ * @return Beats per minute, or 0 before two beats have been detected
+ */
+iirdsp_real iirdsp_qrs_heart_rate(const iirdsp_qrs_t* q)
+{
+    return (q->rr_mean > 0) ? 60.0 * q->fs / q->rr_mean : 0.0;
+}
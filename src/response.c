@@ -0,0 +1,586 @@
+/**
+ * @file response.c
+ * @brief Frequency-response analysis implementation
+ *
+ * The response of each section is
+ *   H_i(e^jw) = (b0 + b1 e^-jw + b2 e^-2jw) / (1 + a1 e^-jw + a2 e^-2jw)
+ *
+ * and its group delay contribution is Re{D_B/B} - Re{D_A/A}, where
+ *   D_B = b1 e^-jw + 2 b2 e^-2jw   (and likewise for A)
+ *
+ * Frequencies are evaluated IIRDSP_FREQZ_BLOCK at a time. The loops over a
+ * block carry no dependency between frequencies, so they vectorize.
+ *
+ * Evaluation is always done in double: near poles on the unit circle
+ * (low-cutoff sections) A(e^jw) suffers cancellation that float cannot
+ * resolve, and this is an analysis path, not the per-sample hot loop.
+ */
+
+#include "response.h"
+#include <math.h>
+#include <limits.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Evaluate one block of frequencies given cos(w) and sin(w)
+ *
+ * @param sections Sections to evaluate
+ * @param num_sections Number of sections
+ * @param cw cos(w) per frequency
+ * @param sw sin(w) per frequency
+ * @param len Number of frequencies in the block (<= IIRDSP_FREQZ_BLOCK)
+ * @param mag Output magnitude, may be NULL
+ * @param phase Output phase, may be NULL
+ * @param group_delay Output group delay, may be NULL
+ */
+static void freqz_block(
+    const iirdsp_biquad_t* sections,
+    int num_sections,
+    const double* cw,
+    const double* sw,
+    int len,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+)
+{
+    double c2w[IIRDSP_FREQZ_BLOCK], s2w[IIRDSP_FREQZ_BLOCK];
+    double h_re[IIRDSP_FREQZ_BLOCK], h_im[IIRDSP_FREQZ_BLOCK];
+    double gd[IIRDSP_FREQZ_BLOCK];
+
+    /* e^-2jw = (e^-jw)^2 */
+    for (int k = 0; k < len; k++) {
+        c2w[k] = cw[k] * cw[k] - sw[k] * sw[k];
+        s2w[k] = 2.0 * cw[k] * sw[k];
+        h_re[k] = 1.0;
+        h_im[k] = 0.0;
+        gd[k] = 0.0;
+    }
+
+    for (int i = 0; i < num_sections; i++) {
+        const iirdsp_biquad_t* s = &sections[i];
+        double b_eps = 1e-20 * (s->b0 * s->b0 + s->b1 * s->b1 + s->b2 * s->b2);
+
+        for (int k = 0; k < len; k++) {
+            /* B(e^jw), A(e^jw) */
+            double num_re = s->b0 + s->b1 * cw[k] + s->b2 * c2w[k];
+            double num_im = -s->b1 * sw[k] - s->b2 * s2w[k];
+            double den_re = 1.0 + s->a1 * cw[k] + s->a2 * c2w[k];
+            double den_im = -s->a1 * sw[k] - s->a2 * s2w[k];
+
+            /* Complex division: H_i = B / A */
+            double den_sq = den_re * den_re + den_im * den_im;
+            double sec_re = (num_re * den_re + num_im * den_im) / den_sq;
+            double sec_im = (num_im * den_re - num_re * den_im) / den_sq;
+
+            /* Accumulate response */
+            double new_re = h_re[k] * sec_re - h_im[k] * sec_im;
+            double new_im = h_re[k] * sec_im + h_im[k] * sec_re;
+            h_re[k] = new_re;
+            h_im[k] = new_im;
+
+            /* Group delay: Re{D_B / B} - Re{D_A / A} */
+            double db_re = s->b1 * cw[k] + 2.0 * s->b2 * c2w[k];
+            double db_im = -s->b1 * sw[k] - 2.0 * s->b2 * s2w[k];
+            double da_re = s->a1 * cw[k] + 2.0 * s->a2 * c2w[k];
+            double da_im = -s->a1 * sw[k] - 2.0 * s->a2 * s2w[k];
+            double num_sq = num_re * num_re + num_im * num_im;
+
+            double tau_b = (num_sq > b_eps) ? (db_re * num_re + db_im * num_im) / num_sq : 0.0;
+            double tau_a = (da_re * den_re + da_im * den_im) / den_sq;
+            gd[k] += tau_b - tau_a;
+        }
+    }
+
+    for (int k = 0; k < len; k++) {
+        if (mag) {
+            mag[k] = sqrt(h_re[k] * h_re[k] + h_im[k] * h_im[k]);
+        }
+        if (phase) {
+            phase[k] = atan2(h_im[k], h_re[k]);
+        }
+        if (group_delay) {
+            group_delay[k] = gd[k];
+        }
+    }
+}
+
+/**
+ * Evaluate the response of a run of sections at arbitrary frequencies
+ *
+ * @param sections Sections to evaluate
+ * @param num_sections Number of sections
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param mag Output magnitude |H|, may be NULL
+ * @param phase Output phase in radians, may be NULL
+ * @param group_delay Output group delay in samples, may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+static int sections_freqz(
+    const iirdsp_biquad_t* sections,
+    int num_sections,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+)
+{
+    if (num_freqs < 0 || fs_hz <= 0.0) {
+        return -1;  /* Invalid parameters */
+    }
+
+    double cw[IIRDSP_FREQZ_BLOCK], sw[IIRDSP_FREQZ_BLOCK];
+
+    for (int n = 0; n < num_freqs; n += IIRDSP_FREQZ_BLOCK) {
+        int len = (num_freqs - n < IIRDSP_FREQZ_BLOCK) ? num_freqs - n : IIRDSP_FREQZ_BLOCK;
+
+        for (int k = 0; k < len; k++) {
+            double w = 2.0 * M_PI * freqs_hz[n + k] / fs_hz;
+            cw[k] = cos(w);
+            sw[k] = sin(w);
+        }
+
+        freqz_block(sections, num_sections, cw, sw, len,
+                    mag ? mag + n : NULL,
+                    phase ? phase + n : NULL,
+                    group_delay ? group_delay + n : NULL);
+    }
+
+    return 0;
+}
+
+/**
+ * Evaluate the frequency response of a filter at arbitrary frequencies
+ *
+ * @param f Filter to evaluate
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param mag Output magnitude |H|, may be NULL
+ * @param phase Output phase in radians, may be NULL
+ * @param group_delay Output group delay in samples, may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_sosfreqz(
+    const iirdsp_filter_t* f,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+)
+{
+    return sections_freqz(f->sections, f->num_sections, freqs_hz, num_freqs, fs_hz,
+                          mag, phase, group_delay);
+}
+
+/**
+ * Evaluate the frequency response of a variable-size cascade
+ *
+ * @param c Cascade to evaluate
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param mag Output magnitude |H|, may be NULL
+ * @param phase Output phase in radians, may be NULL
+ * @param group_delay Output group delay in samples, may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_cascade_sosfreqz(
+    const iirdsp_cascade_t* c,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+)
+{
+    return sections_freqz(c->sections, c->num_sections, freqs_hz, num_freqs, fs_hz,
+                          mag, phase, group_delay);
+}
+
+/**
+ * Evaluate the frequency response on a uniform grid from DC to Nyquist
+ *
+ * @param f Filter to evaluate
+ * @param num_points Number of grid points
+ * @param fs_hz Sampling frequency (Hz)
+ * @param freqs_hz Output grid frequencies (Hz), may be NULL
+ * @param mag Output magnitude |H|, may be NULL
+ * @param phase Output phase in radians, may be NULL
+ * @param group_delay Output group delay in samples, may be NULL
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_sosfreqz_grid(
+    const iirdsp_filter_t* f,
+    int num_points,
+    iirdsp_real fs_hz,
+    iirdsp_real* freqs_hz,
+    iirdsp_real* mag,
+    iirdsp_real* phase,
+    iirdsp_real* group_delay
+)
+{
+    if (num_points <= 0 || fs_hz <= 0.0) {
+        return -1;  /* Invalid parameters */
+    }
+
+    double dw = M_PI / num_points;
+    double rot_re = cos(dw);
+    double rot_im = sin(dw);
+    double cw[IIRDSP_FREQZ_BLOCK], sw[IIRDSP_FREQZ_BLOCK];
+
+    for (int n = 0; n < num_points; n += IIRDSP_FREQZ_BLOCK) {
+        int len = (num_points - n < IIRDSP_FREQZ_BLOCK) ? num_points - n : IIRDSP_FREQZ_BLOCK;
+
+        /* Anchor each block exactly, then rotate by dw within it */
+        cw[0] = cos(n * dw);
+        sw[0] = sin(n * dw);
+        for (int k = 1; k < len; k++) {
+            cw[k] = cw[k-1] * rot_re - sw[k-1] * rot_im;
+            sw[k] = sw[k-1] * rot_re + cw[k-1] * rot_im;
+        }
+
+        if (freqs_hz) {
+            for (int k = 0; k < len; k++) {
+                freqs_hz[n + k] = (n + k) * fs_hz / (2.0 * num_points);
+            }
+        }
+
+        freqz_block(f->sections, f->num_sections, cw, sw, len,
+                    mag ? mag + n : NULL,
+                    phase ? phase + n : NULL,
+                    group_delay ? group_delay + n : NULL);
+    }
+
+    return 0;
+}
+
+/**
+ * Group delay of a single section
+ *
+ * @param s Section to evaluate (state is not used)
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param group_delay Output group delay in samples
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_section_group_delay(
+    const iirdsp_biquad_t* s,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* group_delay
+)
+{
+    iirdsp_filter_t single;
+    single.sections[0] = *s;
+    single.num_sections = 1;
+
+    return iirdsp_sosfreqz(&single, freqs_hz, num_freqs, fs_hz, NULL, NULL, group_delay);
+}
+
+/**
+ * Total group delay of the cascade
+ *
+ * @param f Filter to evaluate
+ * @param freqs_hz Frequencies (Hz), length num_freqs
+ * @param num_freqs Number of frequencies
+ * @param fs_hz Sampling frequency (Hz)
+ * @param group_delay Output group delay in samples
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_group_delay(
+    const iirdsp_filter_t* f,
+    const iirdsp_real* freqs_hz,
+    int num_freqs,
+    iirdsp_real fs_hz,
+    iirdsp_real* group_delay
+)
+{
+    return iirdsp_sosfreqz(f, freqs_hz, num_freqs, fs_hz, NULL, NULL, group_delay);
+}
+
+/**
+ * Summarize group delay over a passband
+ *
+ * The band is walked one IIRDSP_FREQZ_BLOCK at a time so that arbitrarily
+ * fine grids need no allocation.
+ *
+ * @param f Filter to evaluate
+ * @param f_low_hz Lower band edge (Hz)
+ * @param f_high_hz Upper band edge (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param num_points Number of evaluation points (>= 2)
+ * @param summary Output summary
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_passband_delay(
+    const iirdsp_filter_t* f,
+    iirdsp_real f_low_hz,
+    iirdsp_real f_high_hz,
+    iirdsp_real fs_hz,
+    int num_points,
+    iirdsp_delay_summary_t* summary
+)
+{
+    if (num_points < 2 || fs_hz <= 0.0) {
+        return -1;  /* Invalid parameters */
+    }
+    if (f_low_hz < 0.0 || f_high_hz < f_low_hz || f_high_hz > fs_hz / 2.0) {
+        return -2;  /* Invalid frequency range */
+    }
+
+    iirdsp_real step = (f_high_hz - f_low_hz) / (num_points - 1);
+    iirdsp_real freqs[IIRDSP_FREQZ_BLOCK];
+    iirdsp_real gd[IIRDSP_FREQZ_BLOCK];
+    double sum = 0.0;
+
+    summary->max_delay = 0.0;
+    summary->max_delay_hz = f_low_hz;
+    summary->min_delay = 0.0;
+
+    for (int n = 0; n < num_points; n += IIRDSP_FREQZ_BLOCK) {
+        int len = (num_points - n < IIRDSP_FREQZ_BLOCK) ? num_points - n : IIRDSP_FREQZ_BLOCK;
+
+        for (int k = 0; k < len; k++) {
+            freqs[k] = f_low_hz + (n + k) * step;
+        }
+        iirdsp_sosfreqz(f, freqs, len, fs_hz, NULL, NULL, gd);
+
+        for (int k = 0; k < len; k++) {
+            if ((n + k) == 0 || gd[k] > summary->max_delay) {
+                summary->max_delay = gd[k];
+                summary->max_delay_hz = freqs[k];
+            }
+            if ((n + k) == 0 || gd[k] < summary->min_delay) {
+                summary->min_delay = gd[k];
+            }
+            sum += gd[k];
+        }
+    }
+
+    summary->mean_delay = sum / num_points;
+    summary->delay_spread = summary->max_delay - summary->min_delay;
+
+    return 0;
+}
+
+/**
+ * Poles of a section: roots of z^2 + a1*z + a2 (z + a1 if a2 == 0)
+ *
+ * @param s Section
+ * @param p Output poles (complex pairs: re, im), up to 2
+ * @return Number of poles (0, 1 or 2)
+ */
+static int section_poles(const iirdsp_biquad_t* s, double* p)
+{
+    double a1 = s->a1;
+    double a2 = s->a2;
+
+    if (a2 == 0.0) {
+        if (a1 == 0.0) {
+            return 0;
+        }
+        p[0] = -a1;
+        p[1] = 0.0;
+        return 1;
+    }
+
+    double disc = a1 * a1 - 4.0 * a2;
+    if (disc < 0.0) {
+        /* Complex conjugate pair */
+        p[0] = -a1 / 2.0;
+        p[1] = sqrt(-disc) / 2.0;
+        p[2] = p[0];
+        p[3] = -p[1];
+    } else {
+        /* Two real poles (cancellation-free quadratic formula) */
+        double q = -0.5 * (a1 + copysign(sqrt(disc), a1));
+        p[0] = q;
+        p[1] = 0.0;
+        p[2] = a2 / q;
+        p[3] = 0.0;
+    }
+    return 2;
+}
+
+/**
+ * Evaluate c0 + c1*w + c2*w^2 at complex w
+ */
+static void poly2_eval(double c0, double c1, double c2, double w_re, double w_im,
+                       double* re, double* im)
+{
+    /* Horner: (c2*w + c1)*w + c0 */
+    double t_re = c2 * w_re + c1;
+    double t_im = c2 * w_im;
+    *re = t_re * w_re - t_im * w_im + c0;
+    *im = t_re * w_im + t_im * w_re;
+}
+
+/**
+ * Largest pole radius of a section
+ *
+ * @param s Section to evaluate
+ * @return Largest |pole| of the section
+ */
+iirdsp_real iirdsp_section_pole_radius(const iirdsp_biquad_t* s)
+{
+    double p[4];
+    int n = section_poles(s, p);
+    double r = 0.0;
+
+    for (int i = 0; i < n; i++) {
+        double ri = sqrt(p[2*i] * p[2*i] + p[2*i + 1] * p[2*i + 1]);
+        if (ri > r) {
+            r = ri;
+        }
+    }
+    return r;
+}
+
+/**
+ * Sum of the mode envelopes at time n
+ */
+static double mode_envelope(const double* amp, const double* radius, const int* repeated,
+                            int num_modes, double n)
+{
+    double sum = 0.0;
+    for (int m = 0; m < num_modes; m++) {
+        double e = amp[m] * pow(radius[m], n);
+        sum += repeated[m] ? e * (n + 1.0) : e;
+    }
+    return sum;
+}
+
+/**
+ * Estimate the impulse-response length of a filter
+ *
+ * For a simple pole p1 of section s (other pole p2), the residue of the
+ * cascade is
+ *   R = B_s(1/p1) / (1 - p2/p1) * prod_{k != s} H_k(p1)
+ * and the mode contributes R * p1^n to h[n]. A conjugate pair contributes
+ * 2 * Re{R * p1^n}, bounded by 2|R| r^n, and is kept as one mode.
+ *
+ * The envelope sum_m |R_m| r_m^n is monotonically decreasing, so the first
+ * n where it drops below eps is found by bisection.
+ *
+ * @param f Filter to evaluate
+ * @param eps Absolute threshold on |h[n]|
+ * @return Length in samples, -1 if a pole is on or outside the unit circle,
+ *         -2 if eps is not positive, -3 if the length exceeds INT_MAX
+ */
+int iirdsp_impulse_length(const iirdsp_filter_t* f, iirdsp_real eps)
+{
+    double amp[2 * IIRDSP_MAX_SECTIONS];
+    double radius[2 * IIRDSP_MAX_SECTIONS];
+    int repeated[2 * IIRDSP_MAX_SECTIONS];
+    int num_modes = 0;
+
+    if (!(eps > 0.0)) {
+        return -2;  /* The envelope never drops below eps <= 0 */
+    }
+
+    for (int s = 0; s < f->num_sections; s++) {
+        const iirdsp_biquad_t* sec = &f->sections[s];
+        double poles[4];
+        int num_poles = section_poles(sec, poles);
+        int complex_pair = (num_poles == 2 && poles[1] != 0.0);
+
+        for (int i = 0; i < num_poles; i++) {
+            double p_re = poles[2*i];
+            double p_im = poles[2*i + 1];
+            double r = sqrt(p_re * p_re + p_im * p_im);
+            if (r >= 1.0) {
+                return -1;  /* Does not decay */
+            }
+            if (r == 0.0 || (complex_pair && i == 1)) {
+                continue;
+            }
+
+            /* w = 1/p */
+            double w_re = p_re / (r * r);
+            double w_im = -p_im / (r * r);
+
+            /* Own numerator, divided by the (1 - p_other * w) factor */
+            double n_re, n_im;
+            poly2_eval(sec->b0, sec->b1, sec->b2, w_re, w_im, &n_re, &n_im);
+            double a = sqrt(n_re * n_re + n_im * n_im);
+
+            int twin = 0;
+            if (num_poles == 2) {
+                const double* q = &poles[2 * (1 - i)];
+                double d_re = 1.0 - (q[0] * w_re - q[1] * w_im);
+                double d_im = -(q[0] * w_im + q[1] * w_re);
+                double d = sqrt(d_re * d_re + d_im * d_im);
+                if (d > 1e-6) {
+                    a /= d;
+                } else if (i == 1) {
+                    continue;  /* Repeated pole, already counted with its twin */
+                } else {
+                    twin = 1;
+                }
+            }
+
+            /* Gain of every other section at z = p */
+            for (int k = 0; k < f->num_sections; k++) {
+                if (k == s) {
+                    continue;
+                }
+                const iirdsp_biquad_t* o = &f->sections[k];
+                double d_re, d_im;
+                poly2_eval(o->b0, o->b1, o->b2, w_re, w_im, &n_re, &n_im);
+                poly2_eval(1.0, o->a1, o->a2, w_re, w_im, &d_re, &d_im);
+                a *= sqrt((n_re * n_re + n_im * n_im) / (d_re * d_re + d_im * d_im));
+            }
+
+            amp[num_modes] = complex_pair ? 2.0 * a : a;
+            radius[num_modes] = r;
+            repeated[num_modes] = twin;
+            num_modes++;
+        }
+    }
+
+    /* Direct (FIR) terms span at most two taps per section */
+    double length = 2.0 * f->num_sections + 1.0;
+    if (num_modes == 0 || mode_envelope(amp, radius, repeated, num_modes, 0.0) <= eps) {
+        return (int)length;
+    }
+
+    /* Bracket the crossing by doubling, then bisect */
+    double lo = 0.0;
+    double hi = 1.0;
+    while (mode_envelope(amp, radius, repeated, num_modes, hi) > eps) {
+        if (hi > INT_MAX) {
+            return -3;
+        }
+        lo = hi;
+        hi *= 2.0;
+    }
+    for (int it = 0; it < 60 && hi - lo > 0.5; it++) {
+        double mid = 0.5 * (lo + hi);
+        if (mode_envelope(amp, radius, repeated, num_modes, mid) > eps) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (hi + 1.0 > length) {
+        length = hi + 1.0;
+    }
+    if (ceil(length) > INT_MAX) {
+        return -3;
+    }
+    return (int)ceil(length);
+}
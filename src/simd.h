@@ -0,0 +1,200 @@
+/**
+ * @file simd.h
+ * @brief Internal vector abstraction for iirdsp_real kernels
+ *
+ * One vector type and a handful of operations, mapped at compile time to
+ * the widest instruction set the compiler targets:
+ *
+ *   AVX-512F  8 doubles  /  8 floats (256-bit, see below)
+ *   AVX       4 doubles  /  8 floats
+ *   SSE2      2 doubles  /  4 floats
+ *   NEON      2 doubles  /  4 floats  (AArch64)
+ *   scalar    1
+ *
+ * Vectors hold at most 8 lanes, so kernels that work in groups of 8
+ * samples use a whole number of vectors on every target; float on
+ * AVX-512 therefore uses 256-bit registers. Multiply-adds are fused when
+ * the target has FMA (IIRDSP_VEC_FUSED). Loads and stores are unaligned.
+ * iirdsp_fmadd / iirdsp_fnmadd are scalar forms that round like one lane,
+ * for scalar paths that must match a vector kernel exactly.
+ *
+ * Not part of the public API.
+ */
+
+#ifndef IIRDSP_SIMD_H
+#define IIRDSP_SIMD_H
+
+#include "config.h"
+
+#if defined(__AVX512F__) && !defined(IIRDSP_USE_FLOAT)
+#define IIRDSP_VEC_AVX512
+#elif defined(__AVX__)
+#define IIRDSP_VEC_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#define IIRDSP_VEC_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define IIRDSP_VEC_NEON
+#else
+#define IIRDSP_VEC_SCALAR
+#endif
+
+#if defined(IIRDSP_VEC_AVX512)
+#include <immintrin.h>
+typedef __m512d iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 8
+#define IIRDSP_VEC_ISA "avx512"
+#define IIRDSP_VEC_FUSED 1
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return _mm512_loadu_pd(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { _mm512_storeu_pd(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return _mm512_set1_pd(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return _mm512_setzero_pd(); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm512_mul_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm512_add_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm512_sub_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm512_fmadd_pd(a, b, c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm512_fnmadd_pd(a, b, c); }
+
+#elif defined(IIRDSP_VEC_AVX)
+#include <immintrin.h>
+#ifdef IIRDSP_USE_FLOAT
+typedef __m256 iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 8
+#define IIRDSP_VEC_ISA "avx"
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return _mm256_loadu_ps(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { _mm256_storeu_ps(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return _mm256_set1_ps(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return _mm256_setzero_ps(); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm256_mul_ps(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm256_add_ps(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm256_sub_ps(a, b); }
+#ifdef __FMA__
+#define IIRDSP_VEC_FUSED 1
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_fmadd_ps(a, b, c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_fnmadd_ps(a, b, c); }
+#else
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_sub_ps(c, _mm256_mul_ps(a, b)); }
+#endif
+#else
+typedef __m256d iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 4
+#define IIRDSP_VEC_ISA "avx"
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return _mm256_loadu_pd(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { _mm256_storeu_pd(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return _mm256_set1_pd(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return _mm256_setzero_pd(); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm256_mul_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm256_add_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm256_sub_pd(a, b); }
+#ifdef __FMA__
+#define IIRDSP_VEC_FUSED 1
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_fmadd_pd(a, b, c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_fnmadd_pd(a, b, c); }
+#else
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm256_sub_pd(c, _mm256_mul_pd(a, b)); }
+#endif
+#endif
+
+#elif defined(IIRDSP_VEC_SSE2)
+#include <emmintrin.h>
+#ifdef IIRDSP_USE_FLOAT
+typedef __m128 iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 4
+#define IIRDSP_VEC_ISA "sse2"
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return _mm_loadu_ps(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { _mm_storeu_ps(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return _mm_set1_ps(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return _mm_setzero_ps(); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm_mul_ps(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm_add_ps(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm_sub_ps(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+#else
+typedef __m128d iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 2
+#define IIRDSP_VEC_ISA "sse2"
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return _mm_loadu_pd(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { _mm_storeu_pd(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return _mm_set1_pd(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return _mm_setzero_pd(); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm_mul_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm_add_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return _mm_sub_pd(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return _mm_sub_pd(c, _mm_mul_pd(a, b)); }
+#endif
+
+#elif defined(IIRDSP_VEC_NEON)
+#include <arm_neon.h>
+#ifdef IIRDSP_USE_FLOAT
+typedef float32x4_t iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 4
+#define IIRDSP_VEC_ISA "neon"
+#define IIRDSP_VEC_FUSED 1
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return vld1q_f32(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { vst1q_f32(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return vdupq_n_f32(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return vdupq_n_f32(0.0f); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return vmulq_f32(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return vaddq_f32(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return vsubq_f32(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return vfmaq_f32(c, a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return vfmsq_f32(c, a, b); }
+#else
+typedef float64x2_t iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 2
+#define IIRDSP_VEC_ISA "neon"
+#define IIRDSP_VEC_FUSED 1
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return vld1q_f64(p); }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { vst1q_f64(p, a); }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return vdupq_n_f64(a); }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return vdupq_n_f64(0.0); }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return vmulq_f64(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return vaddq_f64(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return vsubq_f64(a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return vfmaq_f64(c, a, b); }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return vfmsq_f64(c, a, b); }
+#endif
+
+#else
+typedef iirdsp_real iirdsp_vec_t;
+#define IIRDSP_VEC_LANES 1
+#define IIRDSP_VEC_ISA "scalar"
+static inline iirdsp_vec_t iirdsp_vec_load(const iirdsp_real* p) { return *p; }
+static inline void iirdsp_vec_store(iirdsp_real* p, iirdsp_vec_t a) { *p = a; }
+static inline iirdsp_vec_t iirdsp_vec_set1(iirdsp_real a) { return a; }
+static inline iirdsp_vec_t iirdsp_vec_zero(void) { return 0; }
+static inline iirdsp_vec_t iirdsp_vec_mul(iirdsp_vec_t a, iirdsp_vec_t b) { return a * b; }
+static inline iirdsp_vec_t iirdsp_vec_add(iirdsp_vec_t a, iirdsp_vec_t b) { return a + b; }
+static inline iirdsp_vec_t iirdsp_vec_sub(iirdsp_vec_t a, iirdsp_vec_t b) { return a - b; }
+static inline iirdsp_vec_t iirdsp_vec_fmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return a * b + c; }
+static inline iirdsp_vec_t iirdsp_vec_fnmadd(iirdsp_vec_t a, iirdsp_vec_t b, iirdsp_vec_t c) { return c - a * b; }
+#endif
+
+#ifndef IIRDSP_VEC_FUSED
+#define IIRDSP_VEC_FUSED 0
+#endif
+
+/*
+ * Semantics on every target:
+ *   iirdsp_vec_fmadd(a, b, c)  = a * b + c
+ *   iirdsp_vec_fnmadd(a, b, c) = c - a * b
+ */
+
+#if IIRDSP_VEC_FUSED
+#include <math.h>
+#ifdef IIRDSP_USE_FLOAT
+static inline iirdsp_real iirdsp_fmadd(iirdsp_real a, iirdsp_real b, iirdsp_real c) { return fmaf(a, b, c); }
+static inline iirdsp_real iirdsp_fnmadd(iirdsp_real a, iirdsp_real b, iirdsp_real c) { return fmaf(-a, b, c); }
+#else
+static inline iirdsp_real iirdsp_fmadd(iirdsp_real a, iirdsp_real b, iirdsp_real c) { return fma(a, b, c); }
+static inline iirdsp_real iirdsp_fnmadd(iirdsp_real a, iirdsp_real b, iirdsp_real c) { return fma(-a, b, c); }
+#endif
+#else
+static inline iirdsp_real iirdsp_fmadd(iirdsp_real a, iirdsp_real b, iirdsp_real c) { return a * b + c; }
+static inline iirdsp_real iirdsp_fnmadd(iirdsp_real a, iirdsp_real b, iirdsp_real c) { return c - a * b; }
+#endif
+
+#endif /* IIRDSP_SIMD_H */
@@ -28,6 +28,181 @@ void iirdsp_process_buffer(
     }
 }
 
+/**
+ * Process a buffer of samples through a variable-size cascade
+ *
+ * @param c Cascade
+ * @param x Input signal (length N)
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_cascade_process_buffer(
+    iirdsp_cascade_t* c,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N
+)
+{
+    for (int n = 0; n < N; n++) {
+        y[n] = iirdsp_cascade_process_sample(c, x[n]);
+    }
+}
+
+/**
+ * Initialize filter state to the steady state for a constant input
+ *
+ * @param f Filter pointer
+ * @param x0 Input level the filter is assumed to have settled on
+ * @return 0 on success, -1 if a section has a pole at DC
+ */
+int iirdsp_filter_init_steady(iirdsp_filter_t* f, iirdsp_real x0)
+{
+    iirdsp_real u = x0;
+
+    for (int i = 0; i < f->num_sections; i++) {
+        iirdsp_biquad_t* s = &f->sections[i];
+        iirdsp_real den = 1.0 + s->a1 + s->a2;
+        if (fabs(den) < 1e-12) {
+            iirdsp_filter_init(f);
+            return -1;  /* Pole at DC: no steady state */
+        }
+
+        iirdsp_real y = (s->b0 + s->b1 + s->b2) / den * u;
+        s->z1 = y - s->b0 * u;
+        s->z2 = s->b2 * u - s->a2 * y;
+        u = y;
+    }
+
+    return 0;
+}
+
+/**
+ * Sign-extend one packed little-endian 24-bit sample
+ */
+static inline int32_t load_i24(const uint8_t* p)
+{
+    uint32_t u = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+    return (int32_t)(u << 8) >> 8;
+}
+
+/**
+ * Round and saturate a sample to int16 (NaN gives 0)
+ */
+static inline int16_t saturate_i16(iirdsp_real v)
+{
+    if (v != v) {
+        return 0;
+    }
+    v += (v >= 0.0) ? 0.5 : -0.5;
+    if (v > 32767.0) {
+        v = 32767.0;
+    } else if (v < -32768.0) {
+        v = -32768.0;
+    }
+    return (int16_t)v;
+}
+
+/**
+ * Process a buffer of int16 ADC samples through the filter
+ *
+ * The conversion loop over each block has no loop-carried dependency and
+ * is vectorized by the compiler; only the recurrence itself runs scalar.
+ *
+ * @param f Filter pointer
+ * @param x Input samples (length N)
+ * @param scale Conversion factor from ADC counts to iirdsp_real units
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_process_buffer_i16(
+    iirdsp_filter_t* f,
+    const int16_t* x,
+    iirdsp_real scale,
+    iirdsp_real* y,
+    int N
+)
+{
+    for (int n = 0; n < N; n += IIRDSP_CONVERT_BLOCK) {
+        int len = (N - n < IIRDSP_CONVERT_BLOCK) ? N - n : IIRDSP_CONVERT_BLOCK;
+
+        /* Convert straight into the output block, then filter in place */
+        for (int i = 0; i < len; i++) {
+            y[n + i] = (iirdsp_real)x[n + i] * scale;
+        }
+        for (int i = 0; i < len; i++) {
+            y[n + i] = iirdsp_process_sample(f, y[n + i]);
+        }
+    }
+}
+
+/**
+ * Process a buffer of packed 24-bit ADC samples through the filter
+ *
+ * @param f Filter pointer
+ * @param x Packed input samples (length 3*N bytes)
+ * @param scale Conversion factor from ADC counts to iirdsp_real units
+ * @param y Output signal (length N)
+ * @param N Number of samples
+ */
+void iirdsp_process_buffer_i24(
+    iirdsp_filter_t* f,
+    const uint8_t* x,
+    iirdsp_real scale,
+    iirdsp_real* y,
+    int N
+)
+{
+    for (int n = 0; n < N; n += IIRDSP_CONVERT_BLOCK) {
+        int len = (N - n < IIRDSP_CONVERT_BLOCK) ? N - n : IIRDSP_CONVERT_BLOCK;
+
+        for (int i = 0; i < len; i++) {
+            y[n + i] = (iirdsp_real)load_i24(&x[3 * (n + i)]) * scale;
+        }
+        for (int i = 0; i < len; i++) {
+            y[n + i] = iirdsp_process_sample(f, y[n + i]);
+        }
+    }
+}
+
+/**
+ * Process int16 samples in, int16 samples out
+ *
+ * Uses a stack block of IIRDSP_CONVERT_BLOCK samples as the only
+ * intermediate storage; no allocation.
+ *
+ * @param f Filter pointer
+ * @param x Input samples (length N)
+ * @param y Output samples (length N)
+ * @param in_scale Conversion factor from input counts to iirdsp_real units
+ * @param out_scale Conversion factor from iirdsp_real units to output counts
+ * @param N Number of samples
+ */
+void iirdsp_process_buffer_i16_i16(
+    iirdsp_filter_t* f,
+    const int16_t* x,
+    int16_t* y,
+    iirdsp_real in_scale,
+    iirdsp_real out_scale,
+    int N
+)
+{
+    iirdsp_real block[IIRDSP_CONVERT_BLOCK];
+
+    for (int n = 0; n < N; n += IIRDSP_CONVERT_BLOCK) {
+        int len = (N - n < IIRDSP_CONVERT_BLOCK) ? N - n : IIRDSP_CONVERT_BLOCK;
+
+        for (int i = 0; i < len; i++) {
+            block[i] = (iirdsp_real)x[n + i] * in_scale;
+        }
+        for (int i = 0; i < len; i++) {
+            block[i] = iirdsp_process_sample(f, block[i]) * out_scale;
+        }
+        for (int i = 0; i < len; i++) {
+            y[n + i] = saturate_i16(block[i]);
+        }
+    }
+}
+
 /**
  * Zero-phase filtering via forward-backward filtering (filtfilt)
  *
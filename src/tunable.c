@@ -0,0 +1,193 @@
+/**
+ * @file tunable.c
+ * @brief Tunable-cutoff Butterworth filter implementation
+ *
+ * butter_*_init puts the whole passband gain correction into the first
+ * section, and for a low-pass that correction scales like cutoff^order,
+ * which interpolates badly. Before tabulating, each section is instead
+ * normalized on its own; the product of unit-gain sections is the same
+ * filter. Retuning is then a handful of multiply-adds per section.
+ */
+
+#include "tunable.h"
+#include <math.h>
+
+/* Mathematical constants */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/**
+ * Normalize one section to unit gain at DC or Nyquist
+ *
+ * H(1) = (b0 + b1 + b2) / (1 + a1 + a2), H(-1) = (b0 - b1 + b2) / (1 - a1 + a2)
+ */
+static void normalize_section(iirdsp_biquad_t* s, iirdsp_btype_t type)
+{
+    iirdsp_real gain;
+
+    if (type == IIRDSP_LOWPASS) {
+        gain = (s->b0 + s->b1 + s->b2) / (1.0 + s->a1 + s->a2);
+    } else {
+        gain = (s->b0 - s->b1 + s->b2) / (1.0 - s->a1 + s->a2);
+    }
+    s->b0 /= gain;
+    s->b1 /= gain;
+    s->b2 /= gain;
+}
+
+/* Write the coefficients for a cutoff into the filter, clamped to the table */
+static void tunable_apply(iirdsp_tunable_t* t, iirdsp_real cutoff_hz)
+{
+    if (!(cutoff_hz > t->f_min_hz)) {
+        cutoff_hz = t->f_min_hz;
+    }
+    if (cutoff_hz > t->f_max_hz) {
+        cutoff_hz = t->f_max_hz;
+    }
+
+    /* Entry from the log spacing, weight from the prewarped frequency */
+    int i = (int)(log(cutoff_hz / t->f_min_hz) * t->points_per_log);
+    if (i > t->num_points - 2) {
+        i = t->num_points - 2;
+    }
+    const iirdsp_real w = tan(M_PI * cutoff_hz / t->fs_hz);
+    const iirdsp_real frac = (w - t->warped[i]) / (t->warped[i + 1] - t->warped[i]);
+
+    for (int k = 0; k < t->filter.num_sections; k++) {
+        iirdsp_biquad_t* s = &t->filter.sections[k];
+        const iirdsp_real* lo = t->table[i][k];
+        const iirdsp_real* hi = t->table[i + 1][k];
+        s->b0 = lo[0] + frac * (hi[0] - lo[0]);
+        s->b1 = lo[1] + frac * (hi[1] - lo[1]);
+        s->b2 = lo[2] + frac * (hi[2] - lo[2]);
+        s->a1 = lo[3] + frac * (hi[3] - lo[3]);
+        s->a2 = lo[4] + frac * (hi[4] - lo[4]);
+    }
+    t->cutoff_hz = cutoff_hz;
+}
+
+/**
+ * Build the coefficient table for a tunable low-pass or high-pass filter
+ *
+ * @param t Tunable filter to initialize
+ * @param type IIRDSP_LOWPASS or IIRDSP_HIGHPASS
+ * @param order Filter order
+ * @param f_min_hz Lowest cutoff frequency (Hz)
+ * @param f_max_hz Highest cutoff frequency (Hz)
+ * @param fs_hz Sampling frequency (Hz)
+ * @param num_points Table size
+ * @return 0 on success, negative error code on failure
+ */
+int iirdsp_tunable_init(
+    iirdsp_tunable_t* t,
+    iirdsp_btype_t type,
+    int order,
+    iirdsp_real f_min_hz,
+    iirdsp_real f_max_hz,
+    iirdsp_real fs_hz,
+    int num_points
+)
+{
+    if ((type != IIRDSP_LOWPASS && type != IIRDSP_HIGHPASS) ||
+        num_points < 2 || num_points > IIRDSP_TUNABLE_MAX_POINTS) {
+        return -3;  /* Invalid type or table size */
+    }
+    if (f_min_hz <= 0.0 || f_max_hz <= f_min_hz) {
+        return -2;  /* Invalid frequency range */
+    }
+
+    const iirdsp_real log_span = log(f_max_hz / f_min_hz);
+
+    for (int p = 0; p < num_points; p++) {
+        /* Hit the end points exactly rather than through exp(log()) */
+        iirdsp_real fc = (p == num_points - 1)
+            ? f_max_hz
+            : f_min_hz * exp(log_span * p / (num_points - 1));
+        int ret = (type == IIRDSP_LOWPASS)
+            ? butter_lowpass_init(&t->filter, order, fc, fs_hz)
+            : butter_highpass_init(&t->filter, order, fc, fs_hz);
+        if (ret != 0) {
+            return ret;
+        }
+
+        t->warped[p] = tan(M_PI * fc / fs_hz);
+        for (int k = 0; k < t->filter.num_sections; k++) {
+            iirdsp_biquad_t* s = &t->filter.sections[k];
+            normalize_section(s, type);
+            t->table[p][k][0] = s->b0;
+            t->table[p][k][1] = s->b1;
+            t->table[p][k][2] = s->b2;
+            t->table[p][k][3] = s->a1;
+            t->table[p][k][4] = s->a2;
+        }
+    }
+
+    t->num_points = num_points;
+    t->f_min_hz = f_min_hz;
+    t->f_max_hz = f_max_hz;
+    t->fs_hz = fs_hz;
+    t->points_per_log = (num_points - 1) / log_span;
+    tunable_apply(t, f_min_hz);
+    iirdsp_filter_init(&t->filter);
+
+    return 0;
+}
+
+/**
+ * Retune to a new cutoff, keeping the filter state
+ *
+ * @param t Tunable filter
+ * @param cutoff_hz New cutoff frequency (Hz)
+ */
+void iirdsp_tunable_set_cutoff(iirdsp_tunable_t* t, iirdsp_real cutoff_hz)
+{
+    tunable_apply(t, cutoff_hz);
+}
+
+/**
+ * Current cutoff frequency
+ *
+ * @param t Tunable filter
+ * @return Cutoff (Hz)
+ */
+iirdsp_real iirdsp_tunable_get_cutoff(const iirdsp_tunable_t* t)
+{
+    return t->cutoff_hz;
+}
+
+/**
+ * Process a buffer while gliding the cutoff to a new value
+ *
+ * @param t Tunable filter
+ * @param x Input signal
+ * @param y Output signal
+ * @param N Number of samples
+ * @param cutoff_end_hz Cutoff at the end of the buffer (Hz)
+ */
+void iirdsp_tunable_process_ramp(
+    iirdsp_tunable_t* t,
+    const iirdsp_real* x,
+    iirdsp_real* y,
+    int N,
+    iirdsp_real cutoff_end_hz
+)
+{
+    const int num_blocks = (N + IIRDSP_TUNABLE_RAMP_BLOCK - 1) / IIRDSP_TUNABLE_RAMP_BLOCK;
+    const iirdsp_real start = t->cutoff_hz;
+    iirdsp_real log_ratio;
+
+    if (N <= 0) {
+        return;
+    }
+    tunable_apply(t, cutoff_end_hz);  /* Clamp the target */
+    log_ratio = log(t->cutoff_hz / start);
+
+    for (int b = 0; b < num_blocks; b++) {
+        int n = b * IIRDSP_TUNABLE_RAMP_BLOCK;
+        int len = (N - n < IIRDSP_TUNABLE_RAMP_BLOCK) ? N - n : IIRDSP_TUNABLE_RAMP_BLOCK;
+
+        tunable_apply(t, start * exp(log_ratio * (b + 1) / num_blocks));
+        iirdsp_process_buffer(&t->filter, x + n, y + n, len);
+    }
+}
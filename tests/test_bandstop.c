@@ -0,0 +1,121 @@
+/**
+ * @file test_bandstop.c
+ * @brief Butterworth band-stop design
+ *
+ * The band-stop must be -3 dB at both edges, unity at DC and Nyquist and
+ * null at the (pre-warped) geometric band centre, with one section per
+ * prototype order. For wide-band rejection it must beat a stack of
+ * notches with the same number of sections.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL_DB 1e-3
+#else
+#define TOL_DB 1e-9
+#endif
+
+#define FS 500.0
+
+/* Least attenuation over 45-65 Hz, most passband loss below 30 / above 90 Hz */
+static void band_metrics(const iirdsp_filter_t* f, iirdsp_real* reject_db, iirdsp_real* pass_db)
+{
+    *reject_db = HUGE_VAL;
+    *pass_db = 0.0;
+    for (int i = 0; i <= 2000; i++) {
+        *reject_db = fmin(*reject_db, loss_db(f, 45.0 + 20.0 * i / 2000, FS));
+    }
+    for (int i = 0; i <= 300; i++) {
+        *pass_db = fmax(*pass_db, loss_db(f, 30.0 * i / 300, FS));
+        *pass_db = fmax(*pass_db, loss_db(f, 90.0 + 160.0 * i / 300, FS));
+    }
+}
+
+int main(void)
+{
+    iirdsp_filter_t f;
+
+    printf("iirdsp Band-Stop Test\n");
+    printf("=====================\n\n");
+
+    /* Response shape */
+    for (int order = 1; order <= 4; order++) {
+        char name[80];
+        const iirdsp_real centre = atan(sqrt(tan(M_PI * 45.0 / FS) * tan(M_PI * 65.0 / FS))) * FS / M_PI;
+        int ret = butter_bandstop_init(&f, order, 45.0, 65.0, FS);
+
+        printf("    order %d: %d sections, edges %.6f / %.6f dB, DC %.2e, Nyquist %.2e, "
+               "centre (%.3f Hz) %.1f dB\n", order, f.num_sections, loss_db(&f, 45.0, FS),
+               loss_db(&f, 65.0, FS), loss_db(&f, 0.0, FS), loss_db(&f, FS / 2.0, FS), centre,
+               loss_db(&f, centre, FS));
+        snprintf(name, sizeof(name), "order %d: -3 dB edges, unity DC/Nyquist", order);
+        check(name, ret == 0 && f.num_sections == order &&
+                    fabs(loss_db(&f, 45.0, FS) - 10.0 * log10(2.0)) < TOL_DB &&
+                    fabs(loss_db(&f, 65.0, FS) - 10.0 * log10(2.0)) < TOL_DB &&
+                    fabs(loss_db(&f, 0.0, FS)) < TOL_DB && fabs(loss_db(&f, FS / 2.0, FS)) < TOL_DB);
+        snprintf(name, sizeof(name), "order %d: null at band centre", order);
+        check(name, loss_db(&f, centre, FS) > 60.0);
+    }
+
+    /* Poles inside, zeros on the unit circle */
+    {
+        int ok;
+        butter_bandstop_init(&f, 4, 45.0, 65.0, FS);
+        ok = sections_stable(f.sections, f.num_sections);
+        for (int i = 0; i < f.num_sections; i++) {
+            ok = ok && fabs(f.sections[i].b2 - f.sections[i].b0) < 1e-6 * f.sections[i].b0;
+        }
+        check("stable, zeros on the unit circle", ok);
+    }
+
+    /* Against four notches spread over the band (same section count) */
+    {
+        iirdsp_filter_t notches, n;
+        const iirdsp_real f0[4] = { 47.5, 52.5, 57.5, 62.5 };
+        iirdsp_real bs_reject, bs_pass, n_reject, n_pass;
+
+        notches.num_sections = 0;
+        for (int i = 0; i < 4; i++) {
+            notch_filter_init(&n, f0[i], 4.0, FS);
+            notches.sections[notches.num_sections++] = n.sections[0];
+        }
+        butter_bandstop_init(&f, 4, 40.0, 72.0, FS);
+        band_metrics(&f, &bs_reject, &bs_pass);
+        band_metrics(&notches, &n_reject, &n_pass);
+
+        printf("    45-65 Hz rejection / passband loss: band-stop %.1f / %.3f dB, "
+               "4 notches %.1f / %.3f dB\n", bs_reject, bs_pass, n_reject, n_pass);
+        check("band-stop beats notch stack", bs_reject > n_reject && bs_pass < n_pass);
+    }
+
+    /* Variable-size cascade past IIRDSP_MAX_SECTIONS */
+    {
+        iirdsp_biquad_t storage[12];
+        iirdsp_cascade_t c;
+        iirdsp_real freq = 55.0, mag;
+
+        iirdsp_cascade_init(&c, storage, 12);
+        int ret = butter_bandstop_init_cascade(&c, 12, 45.0, 65.0, FS);
+        iirdsp_cascade_sosfreqz(&c, &freq, 1, FS, &mag, NULL, NULL);
+        check("order 12 into cascade storage", ret == 0 && c.num_sections == 12 && mag < 1e-3);
+    }
+
+    /* Invalid arguments */
+    check("invalid order rejected",
+          butter_bandstop_init(&f, 0, 45.0, 65.0, FS) == -1 &&
+          butter_bandstop_init(&f, IIRDSP_MAX_SECTIONS + 1, 45.0, 65.0, FS) == -1);
+    check("invalid band edges rejected",
+          butter_bandstop_init(&f, 2, 65.0, 45.0, FS) == -2 &&
+          butter_bandstop_init(&f, 2, 0.0, 45.0, FS) == -2 &&
+          butter_bandstop_init(&f, 2, 45.0, 250.0, FS) == -2);
+
+    return test_summary();
+}
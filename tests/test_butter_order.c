@@ -0,0 +1,122 @@
+/**
+ * @file test_butter_order.c
+ * @brief Minimum-order Butterworth design from a pass/stop specification
+ *
+ * The designed filter must lose exactly gpass at the passband edge and at
+ * least gstop at the stopband edge, and one order less must not be able
+ * to meet both.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL_DB 1e-3
+#else
+#define TOL_DB 1e-9
+#endif
+
+#define FS 500.0
+
+/*
+ * Low-pass or high-pass: the spec is met at the returned order, and the
+ * order below, with its cutoff placed to just meet the passband, misses
+ * the stopband
+ */
+static void check_lp_hp(
+    iirdsp_btype_t type,
+    iirdsp_real wp,
+    iirdsp_real ws,
+    iirdsp_real gpass,
+    iirdsp_real gstop
+)
+{
+    iirdsp_filter_t f;
+    iirdsp_real wn;
+    const char* label = (type == IIRDSP_LOWPASS) ? "LP" : "HP";
+    char name[80];
+
+    int order = butter_order(type, &wp, &ws, gpass, gstop, FS, &wn);
+    butter_init_from_spec(&f, type, &wp, &ws, gpass, gstop, FS);
+    iirdsp_real pass = loss_db(&f, wp, FS);
+    iirdsp_real stop = loss_db(&f, ws, FS);
+    printf("    %s %g/%g Hz, %g/%g dB: order %d, wn %.4f Hz, loss %.6f / %.2f dB\n",
+           label, wp, ws, gpass, gstop, order, wn, pass, stop);
+    snprintf(name, sizeof(name), "%s spec met at order %d", label, order);
+    check(name, fabs(pass - gpass) < TOL_DB && stop >= gstop - TOL_DB);
+
+    /* Order - 1, cutoff from the same edge placement */
+    {
+        const iirdsp_real g_pass = pow(10.0, 0.1 * gpass) - 1.0;
+        const iirdsp_real scale = pow(g_pass, -1.0 / (2.0 * (order - 1)));
+        const iirdsp_real passb = tan(M_PI * wp / FS);
+
+        if (type == IIRDSP_LOWPASS) {
+            butter_lowpass_init(&f, order - 1, atan(scale * passb) * FS / M_PI, FS);
+        } else {
+            butter_highpass_init(&f, order - 1, atan(passb / scale) * FS / M_PI, FS);
+        }
+        printf("    order %d: loss %.6f / %.2f dB\n", order - 1, loss_db(&f, wp, FS), loss_db(&f, ws, FS));
+        snprintf(name, sizeof(name), "%s order %d misses stopband", label, order - 1);
+        check(name, loss_db(&f, ws, FS) < gstop);
+    }
+}
+
+int main(void)
+{
+    iirdsp_filter_t f;
+
+    printf("iirdsp Butterworth Order Test\n");
+    printf("=============================\n\n");
+
+    check_lp_hp(IIRDSP_LOWPASS, 40.0, 60.0, 1.0, 40.0);
+    check_lp_hp(IIRDSP_LOWPASS, 100.0, 150.0, 3.0, 30.0);
+    check_lp_hp(IIRDSP_HIGHPASS, 0.67, 0.1, 3.0, 20.0);
+    check_lp_hp(IIRDSP_HIGHPASS, 5.0, 1.0, 0.5, 60.0);
+
+    /* Band-pass: the prototype order; both stopband edges attenuated */
+    {
+        const iirdsp_real wp[2] = { 5.0, 15.0 };
+        const iirdsp_real ws[2] = { 2.0, 30.0 };
+        iirdsp_real wn[2];
+
+        int order = butter_order(IIRDSP_BANDPASS, wp, ws, 1.0, 30.0, FS, wn);
+        int ret = butter_init_from_spec(&f, IIRDSP_BANDPASS, wp, ws, 1.0, 30.0, FS);
+        printf("    BP 5-15 Hz, stop 2/30 Hz: order %d, wn %.4f-%.4f Hz, loss %.6f %.6f / "
+               "%.2f %.2f dB\n", order, wn[0], wn[1], loss_db(&f, wp[0], FS), loss_db(&f, wp[1], FS),
+               loss_db(&f, ws[0], FS), loss_db(&f, ws[1], FS));
+        check("BP designed with order sections",
+              ret == 0 && f.num_sections == order);
+        check("BP passband edges at gpass",
+              fabs(loss_db(&f, wp[0], FS) - 1.0) < TOL_DB && fabs(loss_db(&f, wp[1], FS) - 1.0) < TOL_DB);
+        check("BP stopband edges at least gstop",
+              loss_db(&f, ws[0], FS) >= 30.0 - TOL_DB && loss_db(&f, ws[1], FS) >= 30.0 - TOL_DB);
+    }
+
+    /* Invalid specifications */
+    {
+        const iirdsp_real lo = 40.0, hi = 60.0, nyq = 250.0, near = 40.5;
+        const iirdsp_real wp[2] = { 5.0, 15.0 };
+        const iirdsp_real ws_inside[2] = { 6.0, 30.0 };
+
+        check("edges not matching type rejected",
+              butter_order(IIRDSP_LOWPASS, &hi, &lo, 1.0, 40.0, FS, NULL) == -2 &&
+              butter_order(IIRDSP_HIGHPASS, &lo, &hi, 1.0, 40.0, FS, NULL) == -2 &&
+              butter_order(IIRDSP_BANDPASS, wp, ws_inside, 1.0, 40.0, FS, NULL) == -2 &&
+              butter_order(IIRDSP_LOWPASS, &lo, &nyq, 1.0, 40.0, FS, NULL) == -2);
+        check("invalid gains or type rejected",
+              butter_order(IIRDSP_LOWPASS, &lo, &hi, 0.0, 40.0, FS, NULL) == -3 &&
+              butter_order(IIRDSP_LOWPASS, &lo, &hi, 3.0, 3.0, FS, NULL) == -3 &&
+              butter_order((iirdsp_btype_t)7, &lo, &hi, 1.0, 40.0, FS, NULL) == -3);
+        check("order beyond IIRDSP_MAX_SECTIONS rejected",
+              butter_init_from_spec(&f, IIRDSP_LOWPASS, &lo, &near, 1.0, 60.0, FS) == -1);
+    }
+
+    return test_summary();
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test_cascade.c
+ * @brief Variable-size cascade over caller-provided section storage
+ *
+ * Within IIRDSP_MAX_SECTIONS the cascade designers must produce exactly
+ * the sections of the fixed-size designers. Beyond it, an order-10
+ * band-pass (10 sections) must meet the Butterworth band edges and be
+ * stable, and a cascade that is too small must be rejected untouched.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#ifndef M_SQRT1_2
+#define M_SQRT1_2 0.70710678118654752440
+#endif
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL 1e-4
+#else
+#define TOL 1e-9
+#endif
+
+#define FS 500.0
+
+/* Identical coefficients section by section */
+static int same_sections(const iirdsp_cascade_t* c, const iirdsp_filter_t* f)
+{
+    if (c->num_sections != f->num_sections) {
+        return 0;
+    }
+    for (int i = 0; i < f->num_sections; i++) {
+        const iirdsp_biquad_t* a = &c->sections[i];
+        const iirdsp_biquad_t* b = &f->sections[i];
+        if (a->b0 != b->b0 || a->b1 != b->b1 || a->b2 != b->b2 ||
+            a->a1 != b->a1 || a->a2 != b->a2) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    iirdsp_biquad_t storage[IIRDSP_DESIGN_MAX_SECTIONS];
+    iirdsp_cascade_t c;
+    iirdsp_filter_t f;
+
+    printf("iirdsp Variable-Size Cascade Test\n");
+    printf("=================================\n\n");
+
+    printf("    sizeof(iirdsp_filter_t) %d bytes, one section %d bytes\n",
+           (int)sizeof(iirdsp_filter_t), (int)sizeof(iirdsp_biquad_t));
+
+    /* Same designs as the fixed-size designers */
+    iirdsp_cascade_init(&c, storage, IIRDSP_DESIGN_MAX_SECTIONS);
+    butter_lowpass_init_cascade(&c, 5, 40.0, FS);
+    butter_lowpass_init(&f, 5, 40.0, FS);
+    check("low-pass matches butter_lowpass_init", same_sections(&c, &f));
+    butter_highpass_init_cascade(&c, 4, 0.5, FS);
+    butter_highpass_init(&f, 4, 0.5, FS);
+    check("high-pass matches butter_highpass_init", same_sections(&c, &f));
+    butter_bandpass_init_cascade(&c, 4, 5.0, 15.0, FS);
+    butter_bandpass_init(&f, 4, 5.0, 15.0, FS);
+    check("band-pass matches butter_bandpass_init", same_sections(&c, &f));
+
+    /* Order-10 band-pass: more sections than iirdsp_filter_t holds */
+    {
+        const iirdsp_real freqs[3] = { 5.0, sqrt(5.0 * 15.0), 15.0 };
+        iirdsp_real mag[3];
+
+        int ret = butter_bandpass_init_cascade(&c, 10, 5.0, 15.0, FS);
+        iirdsp_cascade_sosfreqz(&c, freqs, 3, FS, mag, NULL, NULL);
+        printf("    order 10 band-pass: %d sections, |H| %g / %g / %g\n",
+               c.num_sections, mag[0], mag[1], mag[2]);
+        check("order 10 band-pass designed (10 sections)",
+              ret == 0 && c.num_sections == 10);
+        check("unit gain at band center", fabs(mag[1] - 1.0) < TOL);
+        check("-3 dB at both band edges",
+              fabs(mag[0] - M_SQRT1_2) < TOL && fabs(mag[2] - M_SQRT1_2) < TOL);
+        check("all poles inside unit circle", sections_stable(c.sections, c.num_sections));
+        check("too large for iirdsp_filter_t",
+              butter_bandpass_init(&f, 10, 5.0, 15.0, FS) == -1);
+    }
+
+    /* Too little storage is rejected and leaves the cascade alone */
+    {
+        iirdsp_cascade_t small;
+        iirdsp_cascade_init(&small, storage, 3);
+        check("capacity too small rejected",
+              butter_lowpass_init_cascade(&small, 7, 40.0, FS) == -1 &&
+              butter_bandpass_init_cascade(&small, 4, 5.0, 15.0, FS) == -1 &&
+              small.num_sections == 0);
+        check("exact capacity accepted",
+              butter_lowpass_init_cascade(&small, 6, 40.0, FS) == 0 &&
+              small.num_sections == 3);
+        check("order above design limit rejected",
+              butter_lowpass_init_cascade(&c, 2 * IIRDSP_DESIGN_MAX_SECTIONS + 1, 40.0, FS) == -1);
+    }
+
+    /* One-section cascade */
+    {
+        iirdsp_biquad_t one;
+        iirdsp_cascade_t c1;
+        iirdsp_cascade_init(&c1, &one, 1);
+        butter_highpass_init(&f, 2, 0.5, FS);
+        check("one-section high-pass",
+              butter_highpass_init_cascade(&c1, 2, 0.5, FS) == 0 && same_sections(&c1, &f));
+    }
+
+    /* Buffer path equals the per-sample path, and the fixed filter */
+    {
+        static iirdsp_real x[1000], y[1000];
+        iirdsp_real err = 0.0, err_fixed = 0.0;
+        iirdsp_biquad_t copy[IIRDSP_DESIGN_MAX_SECTIONS];
+        iirdsp_cascade_t a;
+
+        butter_bandpass_init_cascade(&c, 4, 5.0, 15.0, FS);
+        butter_bandpass_init(&f, 4, 5.0, 15.0, FS);
+        iirdsp_cascade_init(&a, copy, IIRDSP_DESIGN_MAX_SECTIONS);
+        butter_bandpass_init_cascade(&a, 4, 5.0, 15.0, FS);
+        iirdsp_cascade_reset(&c);
+        iirdsp_cascade_reset(&a);
+        iirdsp_filter_init(&f);
+        for (int n = 0; n < 1000; n++) {
+            x[n] = sin(0.37 * n) + 0.5 * sin(2.0 * M_PI * 10.0 * n / FS);
+        }
+        iirdsp_cascade_process_buffer(&c, x, y, 1000);
+        for (int n = 0; n < 1000; n++) {
+            err = fmax(err, fabs(iirdsp_cascade_process_sample(&a, x[n]) - y[n]));
+            err_fixed = fmax(err_fixed, fabs(iirdsp_process_sample(&f, x[n]) - y[n]));
+        }
+        check("buffer path matches per-sample path", err == 0.0);
+        check("output matches fixed-size filter", err_fixed == 0.0);
+    }
+
+    return test_summary();
+}
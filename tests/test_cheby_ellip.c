@@ -0,0 +1,169 @@
+/**
+ * @file test_cheby_ellip.c
+ * @brief Chebyshev type I/II and elliptic designs against their definitions
+ *
+ * Each family must place its ripple bands where its definition says:
+ * cheby1 and ellip lose exactly rp_db at the passband edge and never more
+ * inside the passband; cheby2 and ellip attenuate at least rs_db over the
+ * stopband, cheby2 exactly rs_db at its edge. The responses are scanned on
+ * a dense grid, and all designs must be stable.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL_DB 1e-3
+#else
+#define TOL_DB 1e-6
+#endif
+
+#define FS 500.0
+#define GRID 4000
+
+/* Smallest and largest loss over [lo_hz, hi_hz] */
+static void loss_range(
+    const iirdsp_filter_t* f,
+    iirdsp_real lo_hz,
+    iirdsp_real hi_hz,
+    iirdsp_real* min_db,
+    iirdsp_real* max_db
+)
+{
+    *min_db = HUGE_VAL;
+    *max_db = -HUGE_VAL;
+    for (int i = 0; i <= GRID; i++) {
+        iirdsp_real l = loss_db(f, lo_hz + (hi_hz - lo_hz) * i / GRID, FS);
+        *min_db = fmin(*min_db, l);
+        *max_db = fmax(*max_db, l);
+    }
+}
+
+/*
+ * Passband [p_lo, p_hi] ripples within rp_db and ends at edge_hz with
+ * exactly rp_db; stopband [s_lo, s_hi] at least rs_db (skipped if rs_db = 0)
+ */
+static void check_passband(
+    const char* label,
+    const iirdsp_filter_t* f,
+    iirdsp_real rp_db,
+    iirdsp_real edge_hz,
+    iirdsp_real p_lo, iirdsp_real p_hi,
+    iirdsp_real rs_db,
+    iirdsp_real s_lo, iirdsp_real s_hi
+)
+{
+    iirdsp_real pmin, pmax, smin, smax;
+    char name[80];
+
+    loss_range(f, p_lo, p_hi, &pmin, &pmax);
+    printf("    %s: %d sections, passband loss %.6f..%.6f dB, edge %.6f dB\n",
+           label, f->num_sections, pmin, pmax, loss_db(f, edge_hz, FS));
+
+    snprintf(name, sizeof(name), "%s passband ripple", label);
+    check(name, pmin > -TOL_DB && pmax < rp_db + TOL_DB &&
+                fabs(loss_db(f, edge_hz, FS) - rp_db) < TOL_DB);
+    if (rs_db > 0.0) {
+        loss_range(f, s_lo, s_hi, &smin, &smax);
+        printf("    %s: stopband loss >= %.6f dB\n", label, smin);
+        snprintf(name, sizeof(name), "%s stopband attenuation", label);
+        check(name, smin > rs_db - TOL_DB);
+    }
+    snprintf(name, sizeof(name), "%s stable", label);
+    check(name, sections_stable(f->sections, f->num_sections));
+}
+
+/* cheby2: flat passband, exactly rs_db at edge_hz, >= rs_db beyond it */
+static void check_stopband(
+    const char* label,
+    const iirdsp_filter_t* f,
+    iirdsp_real rs_db,
+    iirdsp_real edge_hz,
+    iirdsp_real s_lo, iirdsp_real s_hi,
+    iirdsp_real pass_hz
+)
+{
+    iirdsp_real smin, smax;
+    char name[80];
+
+    loss_range(f, s_lo, s_hi, &smin, &smax);
+    printf("    %s: %d sections, edge %.6f dB, stopband >= %.6f dB, "
+           "passband centre %.6f dB\n", label, f->num_sections,
+           loss_db(f, edge_hz, FS), smin, loss_db(f, pass_hz, FS));
+
+    snprintf(name, sizeof(name), "%s stopband edge at rs", label);
+    check(name, fabs(loss_db(f, edge_hz, FS) - rs_db) < TOL_DB && smin > rs_db - TOL_DB);
+    snprintf(name, sizeof(name), "%s unity passband", label);
+    check(name, fabs(loss_db(f, pass_hz, FS)) < TOL_DB && sections_stable(f->sections, f->num_sections));
+}
+
+int main(void)
+{
+    iirdsp_filter_t f;
+
+    printf("iirdsp Chebyshev / Elliptic Design Test\n");
+    printf("=======================================\n\n");
+
+    /* Chebyshev type I: odd order unity at DC, even order -rp at DC */
+    cheby1_lowpass_init(&f, 5, 1.0, 40.0, FS);
+    check_passband("cheby1 LP order 5", &f, 1.0, 40.0, 0.0, 40.0, 0.0, 0.0, 0.0);
+    check("cheby1 LP odd order: 0 dB at DC", fabs(loss_db(&f, 0.0, FS)) < TOL_DB);
+    cheby1_lowpass_init(&f, 6, 1.0, 40.0, FS);
+    check_passband("cheby1 LP order 6", &f, 1.0, 40.0, 0.0, 40.0, 40.0, 60.0, 250.0);
+    check("cheby1 LP even order: -rp at DC", fabs(loss_db(&f, 0.0, FS) - 1.0) < TOL_DB);
+    cheby1_highpass_init(&f, 4, 0.5, 5.0, FS);
+    check_passband("cheby1 HP order 4", &f, 0.5, 5.0, 5.0, 250.0, 0.0, 0.0, 0.0);
+    cheby1_bandpass_init(&f, 4, 1.0, 5.0, 15.0, FS);
+    check_passband("cheby1 BP order 4", &f, 1.0, 15.0, 5.0, 15.0, 0.0, 0.0, 0.0);
+
+    /* Chebyshev type II */
+    cheby2_lowpass_init(&f, 6, 40.0, 60.0, FS);
+    check_stopband("cheby2 LP order 6", &f, 40.0, 60.0, 60.0, 250.0, 0.0);
+    cheby2_lowpass_init(&f, 5, 40.0, 60.0, FS);
+    check_stopband("cheby2 LP order 5", &f, 40.0, 60.0, 60.0, 250.0, 0.0);
+    cheby2_highpass_init(&f, 5, 40.0, 40.0, FS);
+    check_stopband("cheby2 HP order 5", &f, 40.0, 40.0, 0.0, 40.0, 250.0);
+    cheby2_bandpass_init(&f, 4, 40.0, 5.0, 15.0, FS);
+    check_stopband("cheby2 BP order 4", &f, 40.0, 15.0, 15.0, 250.0, sqrt(5.0 * 15.0));
+
+    /* Elliptic: both bands ripple */
+    ellip_lowpass_init(&f, 4, 1.0, 40.0, 40.0, FS);
+    check_passband("ellip LP order 4", &f, 1.0, 40.0, 0.0, 40.0, 40.0, 60.0, 250.0);
+    ellip_lowpass_init(&f, 5, 0.1, 60.0, 40.0, FS);
+    check_passband("ellip LP order 5", &f, 0.1, 40.0, 0.0, 40.0, 60.0, 80.0, 250.0);
+    ellip_highpass_init(&f, 4, 1.0, 40.0, 60.0, FS);
+    check_passband("ellip HP order 4", &f, 1.0, 60.0, 60.0, 250.0, 40.0, 0.0, 40.0);
+    ellip_bandpass_init(&f, 4, 1.0, 40.0, 5.0, 15.0, FS);
+    check_passband("ellip BP order 4", &f, 1.0, 5.0, 5.0, 15.0, 40.0, 20.0, 250.0);
+
+    /* Same spec (40/60 Hz, 1/40 dB): sections needed per family */
+    {
+        const iirdsp_real wp = 40.0, ws = 60.0;
+        int butter_n = butter_order(IIRDSP_LOWPASS, &wp, &ws, 1.0, 40.0, FS, NULL);
+
+        ellip_lowpass_init(&f, 4, 1.0, 40.0, 40.0, FS);
+        printf("    40/60 Hz, 1/40 dB: Butterworth order %d (%d sections), "
+               "elliptic order 4 (%d sections), loss at 60 Hz %.2f dB\n",
+               butter_n, (butter_n + 1) / 2, f.num_sections, loss_db(&f, 60.0, FS));
+        check("ellip meets spec with under half the sections",
+              loss_db(&f, 60.0, FS) >= 40.0 - TOL_DB && 2 * f.num_sections < (butter_n + 1) / 2);
+    }
+
+    /* Invalid arguments */
+    check("invalid order rejected",
+          cheby1_lowpass_init(&f, 0, 1.0, 40.0, FS) == -1 &&
+          ellip_lowpass_init(&f, 17, 1.0, 40.0, 40.0, FS) == -1 &&
+          cheby2_bandpass_init(&f, 9, 40.0, 5.0, 15.0, FS) == -1);
+    check("invalid frequencies rejected",
+          cheby1_lowpass_init(&f, 4, 1.0, 250.0, FS) == -2 &&
+          cheby2_highpass_init(&f, 4, 40.0, 0.0, FS) == -2 &&
+          ellip_bandpass_init(&f, 4, 1.0, 40.0, 15.0, 5.0, FS) == -2);
+    check("invalid ripple or attenuation rejected",
+          cheby1_lowpass_init(&f, 4, 0.0, 40.0, FS) == -3 &&
+          cheby2_lowpass_init(&f, 4, -3.0, 40.0, FS) == -3 &&
+          ellip_lowpass_init(&f, 4, 1.0, 1.0, 40.0, FS) == -3);
+
+    return test_summary();
+}
@@ -62,44 +62,14 @@ void compute_frequency_response(iirdsp_filter_t* f, const char* name,
     printf("Freq (Hz)    |H(f)| (dB)\n");
     printf("------------------------\n");
     
+    iirdsp_real mag[10];
+    iirdsp_sosfreqz(f, test_freqs, num_test_freqs, fs_hz, mag, NULL, NULL);
+
     for (int i = 0; i < num_test_freqs; i++) {
         iirdsp_real freq = test_freqs[i];
         if (freq > fs_hz / 2.0) continue;
         
-        /* Compute frequency response at this frequency */
-        iirdsp_real w = 2.0 * M_PI * freq / fs_hz;
-        iirdsp_real h_re = 1.0;
-        iirdsp_real h_im = 0.0;
-        
-        for (int j = 0; j < f->num_sections; j++) {
-            /* Numerator */
-            iirdsp_real num_re = f->sections[j].b0 + 
-                                 f->sections[j].b1 * cos(w) + 
-                                 f->sections[j].b2 * cos(2.0 * w);
-            iirdsp_real num_im = -f->sections[j].b1 * sin(w) - 
-                                 f->sections[j].b2 * sin(2.0 * w);
-            
-            /* Denominator */
-            iirdsp_real den_re = 1.0 + 
-                                 f->sections[j].a1 * cos(w) + 
-                                 f->sections[j].a2 * cos(2.0 * w);
-            iirdsp_real den_im = -f->sections[j].a1 * sin(w) - 
-                                 f->sections[j].a2 * sin(2.0 * w);
-            
-            /* Complex division */
-            iirdsp_real denom = den_re * den_re + den_im * den_im;
-            iirdsp_real h_sec_re = (num_re * den_re + num_im * den_im) / denom;
-            iirdsp_real h_sec_im = (num_im * den_re - num_re * den_im) / denom;
-            
-            /* Accumulate */
-            iirdsp_real new_h_re = h_re * h_sec_re - h_im * h_sec_im;
-            iirdsp_real new_h_im = h_re * h_sec_im + h_im * h_sec_re;
-            h_re = new_h_re;
-            h_im = new_h_im;
-        }
-        
-        iirdsp_real mag = sqrt(h_re * h_re + h_im * h_im);
-        iirdsp_real mag_db = 20.0 * log10(mag + 1e-12);
+        iirdsp_real mag_db = 20.0 * log10(mag[i] + 1e-12);
         
         printf("%8.2f    %10.6f\n", freq, mag_db);
     }
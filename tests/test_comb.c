@@ -0,0 +1,172 @@
+/**
+ * @file test_comb.c
+ * @brief Harmonic notch cascade and IIR comb notch
+ *
+ * Steady-state gains are measured by running a tone through the filter
+ * and projecting the settled output onto sine and cosine.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#ifndef M_SQRT1_2
+#define M_SQRT1_2 0.70710678118654752440
+#endif
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL 1e-5
+#else
+#define TOL 1e-12
+#endif
+
+#define FS 500.0
+#define SETTLE 2000
+#define MEASURE 3000
+
+static iirdsp_real x[SETTLE + MEASURE];
+static iirdsp_real y[SETTLE + MEASURE];
+
+static void make_tone(iirdsp_real freq)
+{
+    for (int n = 0; n < SETTLE + MEASURE; n++) {
+        x[n] = (freq == 0.0) ? 1.0 : sin(2.0 * M_PI * freq * n / FS);
+    }
+}
+
+/* Amplitude of the settled output at freq (mean for DC) */
+static iirdsp_real settled_gain(iirdsp_real freq)
+{
+    double s = 0.0, c = 0.0;
+
+    for (int n = SETTLE; n < SETTLE + MEASURE; n++) {
+        s += y[n] * sin(2.0 * M_PI * freq * n / FS);
+        c += y[n] * cos(2.0 * M_PI * freq * n / FS);
+    }
+    if (freq == 0.0) {
+        return fabs(c / MEASURE);
+    }
+    return 2.0 * sqrt(s * s + c * c) / MEASURE;
+}
+
+static iirdsp_real cascade_gain(iirdsp_filter_t* f, iirdsp_real freq)
+{
+    iirdsp_filter_init(f);
+    make_tone(freq);
+    iirdsp_process_buffer(f, x, y, SETTLE + MEASURE);
+    return settled_gain(freq);
+}
+
+static iirdsp_real comb_gain(iirdsp_comb_t* c, iirdsp_real freq)
+{
+    iirdsp_comb_reset(c);
+    make_tone(freq);
+    iirdsp_comb_process_buffer(c, x, y, SETTLE + MEASURE);
+    return settled_gain(freq);
+}
+
+int main(void)
+{
+    iirdsp_filter_t f, single[4];
+    iirdsp_comb_t comb;
+
+    printf("iirdsp Harmonic Notch / IIR Comb Test\n");
+    printf("=====================================\n\n");
+
+    /* Harmonic cascade equals the chained single notches */
+    {
+        iirdsp_real err = 0.0;
+        notch_comb_init(&f, 50.0, 4, 30.0, FS);
+        for (int k = 0; k < 4; k++) {
+            notch_filter_init(&single[k], 50.0 * (k + 1), 30.0, FS);
+        }
+        for (int n = 0; n < 2000; n++) {
+            iirdsp_real v = sin(0.37 * n) + 0.5 * sin(2.0 * M_PI * 100.0 * n / FS);
+            iirdsp_real ref = v;
+            for (int k = 0; k < 4; k++) {
+                ref = iirdsp_process_sample(&single[k], ref);
+            }
+            err = fmax(err, fabs(iirdsp_process_sample(&f, v) - ref));
+        }
+        printf("    max deviation from chained notches %g\n", err);
+        check("notch_comb_init = 4 chained notches", f.num_sections == 4 && err < TOL);
+    }
+
+    {
+        iirdsp_real worst = 0.0;
+        for (int k = 1; k <= 4; k++) {
+            worst = fmax(worst, cascade_gain(&f, 50.0 * k));
+        }
+        iirdsp_real pass = cascade_gain(&f, 75.0);
+        printf("    cascade: worst gain at 50-200 Hz %g, gain at 75 Hz %g\n", worst, pass);
+        check("cascade nulls all harmonics", worst < 1e-3);
+        check("cascade passes between harmonics", pass > 0.99);
+    }
+
+    check("harmonic at Nyquist rejected", notch_comb_init(&f, 50.0, 5, 30.0, FS) == -2);
+    check("too many harmonics rejected",
+          notch_comb_init(&f, 10.0, IIRDSP_MAX_SECTIONS + 1, 30.0, FS) == -1);
+
+    /* Comb with nulls at DC and every multiple of 50 Hz */
+    {
+        iirdsp_real worst = 0.0;
+        iirdsp_comb_init(&comb, 50.0, 30.0, FS, 0);
+        for (int k = 0; k <= 4; k++) {
+            worst = fmax(worst, comb_gain(&comb, 50.0 * k));
+        }
+        iirdsp_real pass = fmin(comb_gain(&comb, 25.0), comb_gain(&comb, 175.0));
+        /* Bandwidth f0 / Q is defined between the -3 dB points */
+        iirdsp_real edge_lo = comb_gain(&comb, 100.0 - 50.0 / 30.0 / 2.0);
+        iirdsp_real edge_hi = comb_gain(&comb, 100.0 + 50.0 / 30.0 / 2.0);
+        printf("    comb: worst null %g, pass %g, band edges %g %g\n",
+               worst, pass, edge_lo, edge_hi);
+        check("comb nulls DC and 50-200 Hz", worst < 1e-3);
+        check("comb passes between nulls", pass > 0.99);
+        check("comb -3 dB points at f0/Q bandwidth",
+              fabs(edge_lo - M_SQRT1_2) < 5e-3 && fabs(edge_hi - M_SQRT1_2) < 5e-3);
+    }
+
+    /* pass_zero: f0 = 100 Hz puts the nulls on the odd mains harmonics */
+    {
+        iirdsp_real worst = 0.0;
+        iirdsp_comb_init(&comb, 100.0, 60.0, FS, 1);
+        worst = fmax(comb_gain(&comb, 50.0), comb_gain(&comb, 150.0));
+        iirdsp_real dc = comb_gain(&comb, 0.0);
+        iirdsp_real even = comb_gain(&comb, 100.0);
+        printf("    pass_zero comb: worst null %g, DC %g, 100 Hz %g\n", worst, dc, even);
+        check("pass_zero comb nulls 50 and 150 Hz", worst < 1e-3);
+        check("pass_zero comb passes DC and 100 Hz",
+              fabs(dc - 1.0) < 1e-3 && fabs(even - 1.0) < 1e-3);
+    }
+
+    /* Buffer path equals the per-sample path, in place, uneven chunks */
+    {
+        iirdsp_comb_t a, b;
+        iirdsp_real err = 0.0;
+        iirdsp_comb_init(&a, 50.0, 30.0, FS, 0);
+        iirdsp_comb_init(&b, 50.0, 30.0, FS, 0);
+        for (int n = 0; n < 1000; n++) {
+            x[n] = sin(0.37 * n) + 0.3 * cos(2.0 * M_PI * 50.0 * n / FS);
+            y[n] = x[n];
+        }
+        iirdsp_comb_process_buffer(&b, y, y, 7);
+        iirdsp_comb_process_buffer(&b, y + 7, y + 7, 13);
+        iirdsp_comb_process_buffer(&b, y + 20, y + 20, 980);
+        for (int n = 0; n < 1000; n++) {
+            err = fmax(err, fabs(iirdsp_comb_process_sample(&a, x[n]) - y[n]));
+        }
+        check("buffer path matches per-sample path", err == 0.0);
+    }
+
+    check("invalid comb parameters rejected",
+          iirdsp_comb_init(&comb, 50.0, 0.0, FS, 0) == -1 &&
+          iirdsp_comb_init(&comb, 60.0, 30.0, FS, 0) == -2 &&
+          iirdsp_comb_init(&comb, 0.5, 30.0, FS, 0) == -2 &&
+          iirdsp_comb_init(&comb, 250.0, 30.0, FS, 0) == 0);
+
+    return test_summary();
+}
@@ -0,0 +1,127 @@
+/**
+ * @file test_coupled.c
+ * @brief Float cascade with coupled-form sections against the double design
+ *
+ * The ECG front end of test_mixed is run in float with every section DF2T,
+ * with the near-unit-circle sections in coupled form, and through the
+ * mixed-precision cascade. The coupled split must reach mixed-precision
+ * accuracy without any double arithmetic.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FS 500.0
+#define NUM_SAMPLES 20000
+
+/* Append the sections of src to dst */
+static void append(iirdsp_filter_t* dst, const iirdsp_filter_t* src)
+{
+    for (int i = 0; i < src->num_sections; i++) {
+        dst->sections[dst->num_sections++] = src->sections[i];
+    }
+}
+
+/* Relative RMS error all-DF2T, coupled split and mixed precision, printed in dB */
+static void measure(
+    const char* label,
+    const iirdsp_filter_t* f,
+    double* e_df2t,
+    double* e_coupled,
+    double* e_mixed
+)
+{
+    static iirdsp_biquad_f64_t wide[IIRDSP_MAX_SECTIONS];
+    static iirdsp_biquad_f32_t narrow[IIRDSP_MAX_SECTIONS];
+    static iirdsp_coupled_t c;
+    static iirdsp_mixed_t m;
+    int n_coupled;
+
+    iirdsp_coupled_init(&c, f, 2.0);
+    *e_df2t = iirdsp_coupled_measure_error(&c, f, NUM_SAMPLES);
+    n_coupled = iirdsp_coupled_init(&c, f, IIRDSP_COUPLED_DEFAULT_RADIUS);
+    *e_coupled = iirdsp_coupled_measure_error(&c, f, NUM_SAMPLES);
+    iirdsp_mixed_attach(&m, wide, IIRDSP_MAX_SECTIONS, narrow, IIRDSP_MAX_SECTIONS);
+    iirdsp_mixed_init(&m, f, IIRDSP_MIXED_DEFAULT_RADIUS);
+    *e_mixed = iirdsp_mixed_measure_error(&m, f, NUM_SAMPLES);
+
+    printf("    %s: %d/%d sections coupled, error DF2T %.1f dB, coupled %.1f dB, "
+           "mixed %.1f dB\n", label, n_coupled, f->num_sections,
+           20.0 * log10(*e_df2t), 20.0 * log10(*e_coupled), 20.0 * log10(*e_mixed));
+}
+
+int main(void)
+{
+    static iirdsp_coupled_t c;
+    iirdsp_filter_t hp, lp, notch, chain;
+    double e_df2t, e_coupled, e_mixed;
+
+    printf("iirdsp Coupled Form Test\n");
+    printf("========================\n\n");
+
+    butter_highpass_init(&hp, 2, 0.5, FS);
+    butter_lowpass_init(&lp, 4, 40.0, FS);
+    notch_filter_init(&notch, 50.0, 30.0, FS);
+    chain.num_sections = 0;
+    append(&chain, &hp);
+    append(&chain, &lp);
+    append(&chain, &notch);
+
+    /* Structure chosen on pole radius: high-pass and notch coupled */
+    iirdsp_coupled_init(&c, &chain, IIRDSP_COUPLED_DEFAULT_RADIUS);
+    for (int i = 0; i < chain.num_sections; i++) {
+        printf("    section %d: pole radius %.5f -> %s\n", i,
+               iirdsp_section_pole_radius(&chain.sections[i]),
+               c.is_coupled[i] ? "coupled" : "DF2T");
+    }
+    check("high-pass and notch coupled, low-pass DF2T",
+          c.num_coupled == 2 && c.is_coupled[0] && !c.is_coupled[1] &&
+          !c.is_coupled[2] && c.is_coupled[3]);
+
+    /* Real poles have no coupled form */
+    butter_highpass_init(&hp, 3, 0.5, FS);
+    check("first-order section stays DF2T",
+          iirdsp_coupled_init(&c, &hp, 0.0) == 1 && !c.is_coupled[0] && c.is_coupled[1]);
+
+    /* With IIRDSP_USE_FLOAT the reference design is itself float, so the
+     * error levels are only checked in the double build */
+    measure("ECG chain", &chain, &e_df2t, &e_coupled, &e_mixed);
+#ifndef IIRDSP_USE_FLOAT
+    check("coupled 40 dB better than all DF2T", e_coupled < 0.01 * e_df2t);
+    check("coupled error below -120 dB", e_coupled < 1e-6);
+    check("coupled within 10 dB of mixed precision", e_coupled < sqrt(10.0) * e_mixed);
+#endif
+
+    /* 0.05 Hz baseline high-pass: DF2T float coefficients alone are off */
+    butter_highpass_init(&hp, 2, 0.05, FS);
+    measure("0.05 Hz high-pass", &hp, &e_df2t, &e_coupled, &e_mixed);
+#ifndef IIRDSP_USE_FLOAT
+    check("0.05 Hz high-pass coupled below -120 dB", e_coupled < 1e-6 && e_df2t > 1e-3);
+#endif
+
+    /* Buffer path equals the per-sample path, in place */
+    {
+        static iirdsp_coupled_t a;
+        static float x[1000], y[1000];
+        float err = 0.0f;
+
+        iirdsp_coupled_init(&c, &chain, IIRDSP_COUPLED_DEFAULT_RADIUS);
+        iirdsp_coupled_init(&a, &chain, IIRDSP_COUPLED_DEFAULT_RADIUS);
+        for (int n = 0; n < 1000; n++) {
+            x[n] = y[n] = (float)(sin(0.37 * n) + 0.5 * sin(2.0 * M_PI * 50.0 * n / FS));
+        }
+        iirdsp_coupled_process_buffer(&c, y, y, 1000);
+        for (int n = 0; n < 1000; n++) {
+            err = fmaxf(err, fabsf(iirdsp_coupled_process_sample(&a, x[n]) - y[n]));
+        }
+        check("buffer path matches per-sample path", err == 0.0f);
+    }
+
+    return test_summary();
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_errfb.c
+ * @brief Float cascade with error feedback against the double design
+ *
+ * The ECG front end of test_mixed is run in float with every section DF2T
+ * and with error feedback on the near-unit-circle sections. Feedback must
+ * bring the float cascade to within 1e-6 of the double design, as the
+ * coupled form does, without changing the section structure.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FS 500.0
+#define NUM_SAMPLES 20000
+
+/* Append the sections of src to dst */
+static void append(iirdsp_filter_t* dst, const iirdsp_filter_t* src)
+{
+    for (int i = 0; i < src->num_sections; i++) {
+        dst->sections[dst->num_sections++] = src->sections[i];
+    }
+}
+
+/* Relative RMS error all-DF2T, error feedback and coupled form, printed in dB */
+static void measure(
+    const char* label,
+    const iirdsp_filter_t* f,
+    double* e_df2t,
+    double* e_feedback,
+    double* e_coupled
+)
+{
+    static iirdsp_errfb_t c;
+    static iirdsp_coupled_t cf;
+    int n_feedback;
+
+    iirdsp_errfb_init(&c, f, 2.0);
+    *e_df2t = iirdsp_errfb_measure_error(&c, f, NUM_SAMPLES);
+    n_feedback = iirdsp_errfb_init(&c, f, IIRDSP_ERRFB_DEFAULT_RADIUS);
+    *e_feedback = iirdsp_errfb_measure_error(&c, f, NUM_SAMPLES);
+    iirdsp_coupled_init(&cf, f, IIRDSP_COUPLED_DEFAULT_RADIUS);
+    *e_coupled = iirdsp_coupled_measure_error(&cf, f, NUM_SAMPLES);
+
+    printf("    %s: %d/%d sections with feedback, error DF2T %.1f dB, "
+           "feedback %.1f dB, coupled %.1f dB\n", label, n_feedback, f->num_sections,
+           20.0 * log10(*e_df2t), 20.0 * log10(*e_feedback), 20.0 * log10(*e_coupled));
+}
+
+int main(void)
+{
+    static iirdsp_errfb_t c;
+    iirdsp_filter_t hp, lp, notch, chain;
+    double e_df2t, e_feedback, e_coupled;
+
+    printf("iirdsp Error Feedback Test\n");
+    printf("==========================\n\n");
+
+    butter_highpass_init(&hp, 2, 0.5, FS);
+    butter_lowpass_init(&lp, 4, 40.0, FS);
+    notch_filter_init(&notch, 50.0, 30.0, FS);
+    chain.num_sections = 0;
+    append(&chain, &hp);
+    append(&chain, &lp);
+    append(&chain, &notch);
+
+    /* Feedback chosen on pole radius: high-pass and notch */
+    check("feedback on high-pass and notch only",
+          iirdsp_errfb_init(&c, &chain, IIRDSP_ERRFB_DEFAULT_RADIUS) == 2 &&
+          c.has_feedback[0] && !c.has_feedback[1] && !c.has_feedback[2] && c.has_feedback[3]);
+    check("radius 0 / 2 give all / none",
+          iirdsp_errfb_init(&c, &chain, 0.0) == 4 && iirdsp_errfb_init(&c, &chain, 2.0) == 0);
+
+    /* With IIRDSP_USE_FLOAT the reference design is itself float, so the
+     * error levels are only checked in the double build */
+    measure("ECG chain", &chain, &e_df2t, &e_feedback, &e_coupled);
+#ifndef IIRDSP_USE_FLOAT
+    check("feedback 40 dB better than all DF2T", e_feedback < 0.01 * e_df2t);
+    check("feedback error below -120 dB", e_feedback < 1e-6);
+#endif
+
+    /* 0.05 Hz baseline high-pass: float a1, a2 alone are off */
+    butter_highpass_init(&hp, 2, 0.05, FS);
+    measure("0.05 Hz high-pass", &hp, &e_df2t, &e_feedback, &e_coupled);
+#ifndef IIRDSP_USE_FLOAT
+    check("0.05 Hz high-pass feedback below -120 dB", e_feedback < 1e-6 && e_df2t > 1e-3);
+#endif
+
+    /* Buffer path equals the per-sample path, in place */
+    {
+        static iirdsp_errfb_t a;
+        static float x[1000], y[1000];
+        float err = 0.0f;
+
+        iirdsp_errfb_init(&c, &chain, IIRDSP_ERRFB_DEFAULT_RADIUS);
+        iirdsp_errfb_init(&a, &chain, IIRDSP_ERRFB_DEFAULT_RADIUS);
+        for (int n = 0; n < 1000; n++) {
+            x[n] = y[n] = (float)(sin(0.37 * n) + 0.5 * sin(2.0 * M_PI * 50.0 * n / FS));
+        }
+        iirdsp_errfb_process_buffer(&c, y, y, 1000);
+        for (int n = 0; n < 1000; n++) {
+            err = fmaxf(err, fabsf(iirdsp_errfb_process_sample(&a, x[n]) - y[n]));
+        }
+        check("buffer path matches per-sample path", err == 0.0f);
+    }
+
+    return test_summary();
+}
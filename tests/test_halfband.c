@@ -0,0 +1,229 @@
+/**
+ * @file test_halfband.c
+ * @brief Polyphase allpass half-band decimator and interpolator
+ *
+ * The designed stage must meet its stopband attenuation above
+ * 0.25 + tbw / 2 and be flat below 0.25 - tbw / 2. The streaming
+ * decimator and interpolator are measured with tones: a passband tone
+ * keeps unit amplitude, a stopband tone (decimation alias or
+ * interpolation image) is rejected by the designed attenuation.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef IIRDSP_USE_FLOAT
+#define PASS_TOL 1e-4
+#else
+#define PASS_TOL 1e-8
+#endif
+
+#define ATTEN_DB 90.0
+#define SETTLE 2048
+#define WINDOW 4096
+
+/* |H(e^jw)| of H(z) = (A0(z^2) + z^-1 A1(z^2)) / 2, f as a fraction of the high rate */
+static double stage_mag(const iirdsp_real* coefs, int n, double f)
+{
+    const double w = 2.0 * M_PI * f;
+    double re[2] = { 1.0, 1.0 }, im[2] = { 0.0, 0.0 };
+
+    for (int i = 0; i < n; i++) {
+        /* (a + z^-2) / (1 + a z^-2) at z^-2 = e^(-2jw) */
+        const double a = coefs[i], c = cos(2.0 * w), s = -sin(2.0 * w);
+        const double nr = a + c, ni = s, dr = 1.0 + a * c, di = a * s;
+        const double d = dr * dr + di * di;
+        const double hr = (nr * dr + ni * di) / d, hi = (ni * dr - nr * di) / d;
+        const double r = re[i % 2] * hr - im[i % 2] * hi;
+        im[i % 2] = re[i % 2] * hi + im[i % 2] * hr;
+        re[i % 2] = r;
+    }
+    /* Branch 1 delayed by one high-rate sample */
+    {
+        const double r = re[1] * cos(w) + im[1] * sin(w);
+        const double i = im[1] * cos(w) - re[1] * sin(w);
+        return 0.5 * hypot(re[0] + r, im[0] + i);
+    }
+}
+
+/* Amplitude of the tone at f (cycles per sample, integer cycles over WINDOW) */
+static double tone_amplitude(const iirdsp_real* y, double f)
+{
+    double re = 0.0, im = 0.0;
+    for (int n = 0; n < WINDOW; n++) {
+        re += y[n] * cos(2.0 * M_PI * f * n);
+        im -= y[n] * sin(2.0 * M_PI * f * n);
+    }
+    return 2.0 * hypot(re, im) / WINDOW;
+}
+
+/* Decimate a unit tone at f_in (fraction of the input rate); amplitude at the output */
+static double decimated_tone(iirdsp_halfband_decimator_t* d, double f_in)
+{
+    static iirdsp_real x[(SETTLE + WINDOW) * 16], y[SETTLE + WINDOW];
+    const int factor = 1 << d->num_stages;
+    const int n_in = (SETTLE + WINDOW) * factor;
+    double f_out = fmod(f_in * factor, 1.0);
+
+    iirdsp_halfband_decimator_reset(d);
+    for (int n = 0; n < n_in; n++) {
+        x[n] = sin(2.0 * M_PI * f_in * n);
+    }
+    iirdsp_halfband_decimator_process(d, x, n_in, y);
+    if (f_out > 0.5) {
+        f_out = 1.0 - f_out;
+    }
+    return tone_amplitude(&y[SETTLE], f_out);
+}
+
+/* Interpolate a unit tone at f_in (fraction of the input rate); amplitude at f_out */
+static double interpolated_tone(iirdsp_halfband_interpolator_t* u, double f_in, double f_out)
+{
+    static iirdsp_real x[SETTLE + WINDOW], y[(SETTLE + WINDOW) * 16];
+    const int factor = 1 << u->num_stages;
+    const int n_in = (SETTLE + WINDOW) / factor;
+
+    iirdsp_halfband_interpolator_reset(u);
+    for (int n = 0; n < n_in; n++) {
+        x[n] = sin(2.0 * M_PI * f_in * n);
+    }
+    iirdsp_halfband_interpolator_process(u, x, n_in, y);
+    return tone_amplitude(&y[SETTLE], f_out);
+}
+
+int main(void)
+{
+    static iirdsp_halfband_decimator_t d;
+    static iirdsp_halfband_interpolator_t u;
+    iirdsp_real coefs[IIRDSP_HALFBAND_MAX_COEFS];
+    int n;
+
+    printf("iirdsp Half-Band Test\n");
+    printf("=====================\n\n");
+
+    /* Design: attenuation above 0.275, flat below 0.225 */
+    n = iirdsp_halfband_design(coefs, IIRDSP_HALFBAND_MAX_COEFS, ATTEN_DB, 0.05);
+    {
+        double stop = HUGE_VAL, ripple = 0.0;
+        int ordered = n > 0 && coefs[0] > 0.0 && coefs[n - 1] < 1.0;
+
+        for (int i = 1; i < n; i++) {
+            ordered = ordered && coefs[i] > coefs[i - 1];
+        }
+        for (int i = 0; i <= 1000; i++) {
+            stop = fmin(stop, -20.0 * log10(stage_mag(coefs, n, 0.275 + 0.225 * i / 1000)));
+            ripple = fmax(ripple, fabs(20.0 * log10(stage_mag(coefs, n, 0.225 * i / 1000))));
+        }
+        printf("    %.0f dB, tbw 0.05: %d coefficients, stopband %.1f dB, "
+               "passband ripple %.1e dB\n", ATTEN_DB, n, stop, ripple);
+        check("coefficients in (0, 1), increasing", ordered);
+        check("stopband meets attenuation", stop >= ATTEN_DB);
+        check("passband flat", ripple < PASS_TOL);
+    }
+    {
+        iirdsp_real c2[IIRDSP_HALFBAND_MAX_COEFS];
+        int n_loose = iirdsp_halfband_design(c2, IIRDSP_HALFBAND_MAX_COEFS, ATTEN_DB, 0.1);
+        int n_deep = iirdsp_halfband_design(c2, IIRDSP_HALFBAND_MAX_COEFS, ATTEN_DB + 30.0, 0.05);
+        check("wider transition / less rejection: fewer", n_loose < n && n_deep > n);
+    }
+
+    /* Against Butterworth-plus-discard for the same band edges */
+    {
+        const iirdsp_real wp = 0.225, ws = 0.275;
+        iirdsp_real wn;
+        int order = butter_order(IIRDSP_LOWPASS, &wp, &ws, 0.1, ATTEN_DB, 1.0, &wn);
+        double butter_mults = 5.0 * ((order + 1) / 2) * 2.0;
+
+        printf("    multiplies per output: half-band %d, Butterworth order %d + discard %.0f\n",
+               n, order, butter_mults);
+        check("cheaper than Butterworth plus discard", n < butter_mults / 10.0);
+    }
+
+    /* Single-stage decimator */
+    iirdsp_halfband_decimator_init(&d, 1, ATTEN_DB, 0.05);
+    {
+        const double pass = decimated_tone(&d, 1000.0 / (2 * WINDOW));
+        const double alias = decimated_tone(&d, 0.5 - 1000.0 / (2 * WINDOW));
+
+        printf("    2x decimation: pass %.6f, alias %.1f dB\n", pass, 20.0 * log10(alias));
+        check("2x: passband tone unchanged", fabs(pass - 1.0) < 1e-3);
+        check("2x: alias rejected", 20.0 * log10(alias) < -ATTEN_DB + 1.0);
+    }
+
+    /* 4x decimator: the first stage needs far fewer coefficients */
+    check("4x decimator init", iirdsp_halfband_decimator_init(&d, 2, ATTEN_DB, 0.05) == 0);
+    {
+        /* Output passband ends at 0.225, so at the input rate 0.05625;
+         * worst aliases land just above 0.225 of the output rate */
+        const double pass = decimated_tone(&d, 900.0 / (4 * WINDOW));
+        const double alias1 = decimated_tone(&d, 0.5 - 900.0 / (4 * WINDOW));
+        const double alias2 = decimated_tone(&d, 0.25 + 900.0 / (4 * WINDOW));
+
+        printf("    4x decimation: stages %d + %d coefficients, pass %.6f, aliases %.1f / %.1f dB\n",
+               d.stages[0].num_coefs, d.stages[1].num_coefs, pass,
+               20.0 * log10(alias1), 20.0 * log10(alias2));
+        check("4x: first stage cheaper", d.stages[0].num_coefs < d.stages[1].num_coefs);
+        check("4x: passband tone unchanged", fabs(pass - 1.0) < 1e-3);
+        check("4x: aliases rejected", 20.0 * log10(fmax(alias1, alias2)) < -ATTEN_DB + 1.0);
+    }
+
+    /* Streaming: odd block sizes give the same output as one call */
+    {
+        static iirdsp_real x[1000], y_one[300], y_blocks[300];
+        static iirdsp_halfband_decimator_t a;
+        int n_one, n_blocks = 0, pos = 0, block = 1;
+        double err = 0.0;
+
+        iirdsp_halfband_decimator_init(&a, 2, ATTEN_DB, 0.05);
+        iirdsp_halfband_decimator_reset(&d);
+        for (int i = 0; i < 1000; i++) {
+            x[i] = sin(0.05 * i) + 0.3 * sin(2.9 * i);
+        }
+        n_one = iirdsp_halfband_decimator_process(&d, x, 1000, y_one);
+        while (pos < 1000) {
+            int len = (pos + block > 1000) ? 1000 - pos : block;
+            n_blocks += iirdsp_halfband_decimator_process(&a, &x[pos], len, &y_blocks[n_blocks]);
+            pos += len;
+            block += 2;
+        }
+        for (int i = 0; i < n_one; i++) {
+            err = fmax(err, fabs(y_one[i] - y_blocks[i]));
+        }
+        check("decimator streams across odd blocks", n_one == 250 && n_blocks == 250 && err == 0.0);
+    }
+
+    /* Interpolators: image of a passband tone rejected */
+    for (int stages = 1; stages <= 2; stages++) {
+        const int factor = 1 << stages;
+        const double f_in = 400.0 * factor / WINDOW;   /* passband ends at 0.45 of the input rate */
+        char name[80];
+        double pass, image;
+
+        iirdsp_halfband_interpolator_init(&u, stages, ATTEN_DB, 0.05);
+        pass = interpolated_tone(&u, f_in, f_in / factor);
+        image = interpolated_tone(&u, f_in, (1.0 - f_in) / factor);
+        printf("    %dx interpolation: pass %.6f, image %.1f dB\n", factor, pass,
+               20.0 * log10(image));
+        snprintf(name, sizeof(name), "%dx: passband unity, image rejected", factor);
+        check(name, fabs(pass - 1.0) < 1e-3 && 20.0 * log10(image) < -ATTEN_DB + 1.0);
+    }
+
+    /* Invalid arguments */
+    check("invalid stage count rejected",
+          iirdsp_halfband_decimator_init(&d, 0, ATTEN_DB, 0.05) == -1 &&
+          iirdsp_halfband_interpolator_init(&u, IIRDSP_HALFBAND_MAX_STAGES + 1, ATTEN_DB, 0.05) == -1);
+    check("invalid specification rejected",
+          iirdsp_halfband_design(coefs, IIRDSP_HALFBAND_MAX_COEFS, 0.0, 0.05) == -2 &&
+          iirdsp_halfband_design(coefs, IIRDSP_HALFBAND_MAX_COEFS, ATTEN_DB, 0.5) == -2);
+    check("too many coefficients rejected",
+          iirdsp_halfband_design(coefs, 4, ATTEN_DB, 0.05) == -3 &&
+          iirdsp_halfband_decimator_init(&d, 1, 200.0, 0.001) == -3);
+
+    return test_summary();
+}
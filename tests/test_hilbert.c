@@ -0,0 +1,147 @@
+/**
+ * @file test_hilbert.c
+ * @brief Streaming IIR Hilbert transformer and envelope
+ *
+ * Across the design band I and Q must keep unit gain and stay within the
+ * designed phase error of 90 degrees, Q lagging. The envelope of a tone
+ * must be flat, follow an amplitude modulation, and rise within a few
+ * tens of milliseconds of a burst onset.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifdef IIRDSP_USE_FLOAT
+#define GAIN_TOL 1e-4
+#else
+#define GAIN_TOL 1e-9
+#endif
+
+#define FS 500.0
+#define F_LOW 5.0
+#define PHASE_ERR_DEG 0.5
+#define SETTLE 2000
+#define WINDOW 5000     /* 10 s: integer cycles for whole-Hz tones */
+
+/* Complex amplitude of the tone at f in y[SETTLE .. SETTLE + WINDOW) */
+static void tone(const iirdsp_real* y, double f, double* re, double* im)
+{
+    *re = 0.0;
+    *im = 0.0;
+    for (int n = SETTLE; n < SETTLE + WINDOW; n++) {
+        *re += y[n] * cos(2.0 * M_PI * f * n / FS) * 2.0 / WINDOW;
+        *im -= y[n] * sin(2.0 * M_PI * f * n / FS) * 2.0 / WINDOW;
+    }
+}
+
+int main(void)
+{
+    static iirdsp_real x[SETTLE + WINDOW], i[SETTLE + WINDOW], q[SETTLE + WINDOW];
+    static iirdsp_real env[SETTLE + WINDOW];
+    iirdsp_hilbert_t h;
+
+    printf("iirdsp Hilbert Transformer Test\n");
+    printf("===============================\n\n");
+
+    check("init 5-245 Hz, 0.5 deg",
+          iirdsp_hilbert_init(&h, F_LOW, FS, PHASE_ERR_DEG) == 0);
+    printf("    sections: I %d, Q %d\n", h.in_phase.num_sections, h.quadrature.num_sections);
+
+    /* Unit gain and 90 degrees (Q lagging) across the band */
+    {
+        double worst_phase = 0.0, worst_gain = 0.0;
+
+        for (double f = F_LOW; f <= FS / 2.0 - F_LOW; f += 5.0) {
+            double ir, ii, qr, qi, diff;
+
+            iirdsp_hilbert_reset(&h);
+            for (int n = 0; n < SETTLE + WINDOW; n++) {
+                x[n] = cos(2.0 * M_PI * f * n / FS);
+            }
+            iirdsp_hilbert_process_buffer(&h, x, i, q, SETTLE + WINDOW);
+            tone(i, f, &ir, &ii);
+            tone(q, f, &qr, &qi);
+            diff = (atan2(ii, ir) - atan2(qi, qr)) * 180.0 / M_PI;
+            diff = fmod(diff + 360.0, 360.0);
+            worst_phase = fmax(worst_phase, fabs(diff - 90.0));
+            worst_gain = fmax(worst_gain, fabs(hypot(ir, ii) - 1.0));
+            worst_gain = fmax(worst_gain, fabs(hypot(qr, qi) - 1.0));
+        }
+        printf("    5-245 Hz: worst phase error %.4f deg, worst gain error %.1e\n",
+               worst_phase, worst_gain);
+        check("Q lags I by 90 deg within design error", worst_phase <= PHASE_ERR_DEG + 1e-3);
+        check("I and Q unit gain", worst_gain < GAIN_TOL);
+    }
+
+    /* Envelope of a steady tone is flat */
+    {
+        double lo = HUGE_VAL, hi = 0.0;
+
+        iirdsp_hilbert_reset(&h);
+        for (int n = 0; n < SETTLE + WINDOW; n++) {
+            x[n] = 2.0 * sin(2.0 * M_PI * 17.0 * n / FS);
+        }
+        iirdsp_hilbert_envelope_buffer(&h, x, env, SETTLE + WINDOW);
+        for (int n = SETTLE; n < SETTLE + WINDOW; n++) {
+            lo = fmin(lo, env[n]);
+            hi = fmax(hi, env[n]);
+        }
+        printf("    17 Hz tone, amplitude 2: envelope %.5f .. %.5f\n", lo, hi);
+        check("tone envelope flat within phase error",
+              lo > 2.0 * (1.0 - PHASE_ERR_DEG * M_PI / 180.0) &&
+              hi < 2.0 * (1.0 + PHASE_ERR_DEG * M_PI / 180.0));
+    }
+
+    /* Envelope follows 1 Hz amplitude modulation of a 40 Hz carrier */
+    {
+        double err = 0.0;
+        const int delay = 2;    /* group delay around 40 Hz, samples */
+
+        iirdsp_hilbert_reset(&h);
+        for (int n = 0; n < SETTLE + WINDOW; n++) {
+            x[n] = (1.0 + 0.5 * sin(2.0 * M_PI * 1.0 * n / FS)) * cos(2.0 * M_PI * 40.0 * n / FS);
+        }
+        iirdsp_hilbert_envelope_buffer(&h, x, env, SETTLE + WINDOW);
+        for (int n = SETTLE; n < SETTLE + WINDOW; n++) {
+            err = fmax(err, fabs(env[n] - (1.0 + 0.5 * sin(2.0 * M_PI * 1.0 * (n - delay) / FS))));
+        }
+        printf("    AM 1 Hz on 40 Hz: worst envelope error %.4f\n", err);
+        check("envelope follows amplitude modulation", err < 0.02);
+    }
+
+    /* Latency: envelope of a 20 Hz burst reaches half amplitude quickly */
+    {
+        const int onset = 1000;
+        int rise = -1;
+
+        iirdsp_hilbert_reset(&h);
+        for (int n = 0; n < 2000; n++) {
+            x[n] = (n >= onset) ? sin(2.0 * M_PI * 20.0 * (n - onset) / FS) : 0.0;
+        }
+        iirdsp_hilbert_envelope_buffer(&h, x, env, 2000);
+        for (int n = onset; n < 2000 && rise < 0; n++) {
+            if (env[n] >= 0.5) {
+                rise = n - onset;
+            }
+        }
+        printf("    20 Hz burst: envelope at half amplitude after %d samples (%.0f ms)\n",
+               rise, 1000.0 * rise / FS);
+        check("envelope latency under 20 ms", rise >= 0 && rise < 0.02 * FS);
+    }
+
+    /* Invalid arguments */
+    check("invalid band rejected",
+          iirdsp_hilbert_init(&h, 0.0, FS, PHASE_ERR_DEG) == -2 &&
+          iirdsp_hilbert_init(&h, FS / 4.0, FS, PHASE_ERR_DEG) == -2);
+    check("invalid phase error / too many sections",
+          iirdsp_hilbert_init(&h, F_LOW, FS, 0.0) == -3 &&
+          iirdsp_hilbert_init(&h, 0.01, FS, 0.001) == -3);
+
+    return test_summary();
+}
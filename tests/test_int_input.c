@@ -0,0 +1,106 @@
+/**
+ * @file test_int_input.c
+ * @brief Fused integer-input paths must match the iirdsp_real path
+ *
+ * Filters the same ADC record through iirdsp_process_buffer (after a
+ * manual conversion) and through the int16 / packed int24 entry points,
+ * and checks int16 output saturation.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+
+#define N 1000
+
+int main(void)
+{
+    iirdsp_filter_t f;
+    int16_t x16[N];
+    uint8_t x24[3 * N];
+    int16_t y16[N];
+    iirdsp_real xr[N], ref[N], y[N];
+    const iirdsp_real scale = 1.0 / 8388608.0;
+    int failures = 0;
+
+    printf("iirdsp Integer Input Test\n");
+    printf("=========================\n\n");
+
+    for (int n = 0; n < N; n++) {
+        int32_t v = (int32_t)(8000000.0 * sin(0.05 * n)) - (n % 7) * 1000;
+        x16[n] = (int16_t)(v >> 8);
+        x24[3*n]     = (uint8_t)(v & 0xFF);
+        x24[3*n + 1] = (uint8_t)((v >> 8) & 0xFF);
+        x24[3*n + 2] = (uint8_t)((v >> 16) & 0xFF);
+        xr[n] = (iirdsp_real)v * scale;
+    }
+
+    /* Packed 24-bit path */
+    notch_filter_init(&f, 50.0, 30.0, 500.0);
+    iirdsp_process_buffer(&f, xr, ref, N);
+    notch_filter_init(&f, 50.0, 30.0, 500.0);
+    iirdsp_process_buffer_i24(&f, x24, scale, y, N);
+
+    iirdsp_real err = 0.0;
+    for (int n = 0; n < N; n++) {
+        err = fmax(err, fabs(y[n] - ref[n]));
+    }
+    printf("int24 max abs error: %g\n", err);
+    if (err > 1e-6) {
+        failures++;
+    }
+
+    /* int16 path */
+    for (int n = 0; n < N; n++) {
+        xr[n] = (iirdsp_real)x16[n] * (256.0 * scale);
+    }
+    notch_filter_init(&f, 50.0, 30.0, 500.0);
+    iirdsp_process_buffer(&f, xr, ref, N);
+    notch_filter_init(&f, 50.0, 30.0, 500.0);
+    iirdsp_process_buffer_i16(&f, x16, 256.0 * scale, y, N);
+
+    err = 0.0;
+    for (int n = 0; n < N; n++) {
+        err = fmax(err, fabs(y[n] - ref[n]));
+    }
+    printf("int16 max abs error: %g\n", err);
+    if (err > 1e-6) {
+        failures++;
+    }
+
+    /* int16 -> int16 with 4x gain must saturate, never wrap */
+    notch_filter_init(&f, 50.0, 30.0, 500.0);
+    iirdsp_process_buffer_i16_i16(&f, x16, y16, 1.0, 4.0, N);
+
+    int saturated = 0;
+    for (int n = 0; n < N; n++) {
+        iirdsp_real expected = 4.0 * ref[n] / (256.0 * scale);
+        if (expected > 32767.0 && y16[n] != 32767) failures++;
+        if (expected < -32768.0 && y16[n] != -32768) failures++;
+        if (fabs(expected) < 32000.0 && fabs(y16[n] - expected) > 0.5 + 1e-6) failures++;
+        if (y16[n] == 32767 || y16[n] == -32768) saturated++;
+    }
+    printf("int16 output: %d saturated samples\n", saturated);
+    if (saturated == 0) {
+        failures++;
+    }
+
+    /* NaN output is written as 0, not converted out of range */
+    iirdsp_filter_reset(&f);
+    iirdsp_process_buffer_i16_i16(&f, x16, y16, 1.0, NAN, N);
+    int nonzero = 0;
+    for (int n = 0; n < N; n++) {
+        if (y16[n] != 0) nonzero++;
+    }
+    printf("int16 output from NaN: %d nonzero samples\n", nonzero);
+    if (nonzero != 0) {
+        failures++;
+    }
+
+    if (failures == 0) {
+        printf("\n✓ Test PASSED\n");
+        return 0;
+    }
+    printf("\n✗ Test FAILED (%d failures)\n", failures);
+    return -1;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_mixed.c
+ * @brief Mixed-precision cascade against the double design
+ *
+ * An ECG front end (0.5 Hz high-pass, 40 Hz low-pass, 50 Hz notch) is run
+ * all-float, mixed and all-double with float I/O. The split must put the
+ * near-unit-circle sections in double, which takes the error from float
+ * levels to well below 20 bits. Sections live in caller storage sized
+ * for the split.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FS 500.0
+#define NUM_SAMPLES 20000
+
+/* Append the sections of src to dst */
+static void append(iirdsp_filter_t* dst, const iirdsp_filter_t* src)
+{
+    for (int i = 0; i < src->num_sections; i++) {
+        dst->sections[dst->num_sections++] = src->sections[i];
+    }
+}
+
+/* Relative RMS error at three split points, printed in dB */
+static void measure(
+    const char* label,
+    const iirdsp_filter_t* f,
+    double* e_float,
+    double* e_mixed,
+    double* e_double
+)
+{
+    static iirdsp_biquad_f64_t wide[IIRDSP_MAX_SECTIONS];
+    static iirdsp_biquad_f32_t narrow[IIRDSP_MAX_SECTIONS];
+    static iirdsp_mixed_t m;
+    int n_double;
+
+    iirdsp_mixed_attach(&m, wide, IIRDSP_MAX_SECTIONS, narrow, IIRDSP_MAX_SECTIONS);
+    iirdsp_mixed_init(&m, f, 2.0);
+    *e_float = iirdsp_mixed_measure_error(&m, f, NUM_SAMPLES);
+    n_double = iirdsp_mixed_init(&m, f, IIRDSP_MIXED_DEFAULT_RADIUS);
+    *e_mixed = iirdsp_mixed_measure_error(&m, f, NUM_SAMPLES);
+    iirdsp_mixed_init(&m, f, 0.0);
+    *e_double = iirdsp_mixed_measure_error(&m, f, NUM_SAMPLES);
+
+    printf("    %s: %d/%d sections double, error float %.1f dB, mixed %.1f dB, "
+           "double %.1f dB\n", label, n_double, f->num_sections,
+           20.0 * log10(*e_float), 20.0 * log10(*e_mixed), 20.0 * log10(*e_double));
+}
+
+int main(void)
+{
+    static iirdsp_biquad_f64_t wide[IIRDSP_MAX_SECTIONS];
+    static iirdsp_biquad_f32_t narrow[IIRDSP_MAX_SECTIONS];
+    static iirdsp_mixed_t m;
+    iirdsp_filter_t hp, lp, notch, chain;
+    double e_float, e_mixed, e_double;
+
+    printf("iirdsp Mixed Precision Test\n");
+    printf("===========================\n\n");
+
+    butter_highpass_init(&hp, 2, 0.5, FS);
+    butter_lowpass_init(&lp, 4, 40.0, FS);
+    notch_filter_init(&notch, 50.0, 30.0, FS);
+    chain.num_sections = 0;
+    append(&chain, &hp);
+    append(&chain, &lp);
+    append(&chain, &notch);
+
+    /* Split on pole radius: high-pass and notch go double */
+    iirdsp_mixed_attach(&m, wide, IIRDSP_MAX_SECTIONS, narrow, IIRDSP_MAX_SECTIONS);
+    iirdsp_mixed_init(&m, &chain, IIRDSP_MIXED_DEFAULT_RADIUS);
+    for (int i = 0; i < chain.num_sections; i++) {
+        printf("    section %d: pole radius %.5f -> %s\n", i,
+               iirdsp_section_pole_radius(&chain.sections[i]),
+               m.is_double[i] ? "double" : "float");
+    }
+    check("high-pass and notch double, low-pass float",
+          m.num_double == 2 && m.is_double[0] && !m.is_double[1] &&
+          !m.is_double[2] && m.is_double[3]);
+    check("split 0 / >= 1 gives all double / all float",
+          iirdsp_mixed_init(&m, &chain, 0.0) == 4 && iirdsp_mixed_init(&m, &chain, 1.0) == 0);
+
+    /* Storage sized for the split: exact fits, one short is rejected */
+    {
+        iirdsp_mixed_t exact;
+        const int nd = iirdsp_mixed_num_double(&chain, IIRDSP_MIXED_DEFAULT_RADIUS);
+
+        iirdsp_mixed_attach(&exact, wide, nd, narrow, chain.num_sections - nd);
+        check("storage sized by num_double accepted",
+              nd == 2 && iirdsp_mixed_init(&exact, &chain, IIRDSP_MIXED_DEFAULT_RADIUS) == 2);
+        iirdsp_mixed_attach(&exact, wide, nd - 1, narrow, IIRDSP_MAX_SECTIONS);
+        check("too few double sections rejected",
+              iirdsp_mixed_init(&exact, &chain, IIRDSP_MIXED_DEFAULT_RADIUS) == -1 &&
+              exact.num_sections == 0);
+        iirdsp_mixed_attach(&exact, wide, IIRDSP_MAX_SECTIONS, narrow, 1);
+        check("too few float sections rejected",
+              iirdsp_mixed_init(&exact, &chain, IIRDSP_MIXED_DEFAULT_RADIUS) == -1);
+    }
+
+    /* With IIRDSP_USE_FLOAT the reference design is itself float, so the
+     * error levels are only checked in the double build */
+    measure("ECG chain", &chain, &e_float, &e_mixed, &e_double);
+#ifndef IIRDSP_USE_FLOAT
+    check("mixed 40 dB better than all float", e_mixed < 0.01 * e_float);
+    check("mixed error below -120 dB", e_mixed < 1e-6);
+    check("all double limited by float I/O (< -140 dB)", e_double < 1e-7);
+#endif
+
+    /* 0.05 Hz baseline high-pass: float coefficients alone are off */
+    butter_highpass_init(&hp, 2, 0.05, FS);
+    measure("0.05 Hz high-pass", &hp, &e_float, &e_mixed, &e_double);
+#ifndef IIRDSP_USE_FLOAT
+    check("0.05 Hz high-pass runs in double", e_mixed == e_double);
+    check("all float error above -60 dB", e_float > 1e-3);
+#endif
+
+    /* Buffer path equals the per-sample path, in place */
+    {
+        static iirdsp_biquad_f64_t a_wide[IIRDSP_MAX_SECTIONS];
+        static iirdsp_biquad_f32_t a_narrow[IIRDSP_MAX_SECTIONS];
+        static iirdsp_mixed_t a;
+        static float x[1000], y[1000];
+        float err = 0.0f;
+
+        iirdsp_mixed_attach(&a, a_wide, IIRDSP_MAX_SECTIONS, a_narrow, IIRDSP_MAX_SECTIONS);
+        iirdsp_mixed_attach(&m, wide, IIRDSP_MAX_SECTIONS, narrow, IIRDSP_MAX_SECTIONS);
+        iirdsp_mixed_init(&m, &chain, IIRDSP_MIXED_DEFAULT_RADIUS);
+        iirdsp_mixed_init(&a, &chain, IIRDSP_MIXED_DEFAULT_RADIUS);
+        for (int n = 0; n < 1000; n++) {
+            x[n] = y[n] = (float)(sin(0.37 * n) + 0.5 * sin(2.0 * M_PI * 50.0 * n / FS));
+        }
+        iirdsp_mixed_process_buffer(&m, y, y, 1000);
+        for (int n = 0; n < 1000; n++) {
+            err = fmaxf(err, fabsf(iirdsp_mixed_process_sample(&a, x[n]) - y[n]));
+        }
+        check("buffer path matches per-sample path", err == 0.0f);
+    }
+
+    return test_summary();
+}
@@ -0,0 +1,217 @@
+/**
+ * @file test_response.c
+ * @brief Frequency-response engine and Butterworth design checks
+ *
+ * Verifies iirdsp_sosfreqz against closed-form Butterworth properties
+ * (unit passband gain, -3 dB at the cutoff edges, stable sections),
+ * grid vs arbitrary-frequency agreement, and analytic group delay vs a
+ * numerical derivative of the phase.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define GRID 4096
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL 1e-4
+#define GD_TOL 0.2
+#else
+#define TOL 1e-9
+#define GD_TOL 1e-4
+#endif
+
+/* check() with the measured value printed */
+static void check_value(int ok, const char* what, double value)
+{
+    printf("  %-44s %s (%g)\n", what, ok ? "ok" : "FAIL", value);
+    if (!ok) {
+        failures++;
+    }
+}
+
+static int simulated_length(iirdsp_filter_t* f, iirdsp_real eps)
+{
+    int last = 0;
+    iirdsp_filter_reset(f);
+    for (int n = 0; n < 50000; n++) {
+        iirdsp_real y = iirdsp_process_sample(f, n == 0 ? 1.0 : 0.0);
+        if (fabs(y) > eps) {
+            last = n;
+        }
+    }
+    return last + 1;
+}
+
+static iirdsp_real mag_at(const iirdsp_filter_t* f, iirdsp_real freq, iirdsp_real fs)
+{
+    iirdsp_real m;
+    iirdsp_sosfreqz(f, &freq, 1, fs, &m, NULL, NULL);
+    return m;
+}
+
+int main(void)
+{
+    iirdsp_filter_t f;
+    const iirdsp_real fs = 500.0;
+    const iirdsp_real edge = 1.0 / sqrt(2.0);
+
+    printf("iirdsp Frequency Response Test\n");
+    printf("==============================\n\n");
+
+    /* Order-2 low-pass against the closed-form bilinear design */
+    printf("Low-pass order 2, 10 Hz:\n");
+    butter_lowpass_init(&f, 2, 10.0, fs);
+    {
+        double K = tan(M_PI * 10.0 / 500.0);
+        double norm = 1.0 + sqrt(2.0) * K + K * K;
+        double b0 = K * K / norm;
+        double a1 = 2.0 * (K * K - 1.0) / norm;
+        double a2 = (1.0 - sqrt(2.0) * K + K * K) / norm;
+        double err = fabs(f.sections[0].b0 - b0) + fabs(f.sections[0].b1 - 2.0 * b0)
+                   + fabs(f.sections[0].b2 - b0) + fabs(f.sections[0].a1 - a1)
+                   + fabs(f.sections[0].a2 - a2);
+        check_value(err < TOL, "coefficients match closed form", err);
+    }
+
+    for (int order = 1; order <= 2 * IIRDSP_MAX_SECTIONS; order++) {
+        char what[64];
+        butter_lowpass_init(&f, order, 10.0, fs);
+        iirdsp_real e = fabs(mag_at(&f, 10.0, fs) - edge) + fabs(mag_at(&f, 0.0, fs) - 1.0);
+        snprintf(what, sizeof(what), "low-pass order %d: -3 dB edge, unit DC", order);
+        check_value(e < 1e3 * TOL && sections_stable(f.sections, f.num_sections), what, e);
+
+        butter_highpass_init(&f, order, 40.0, fs);
+        e = fabs(mag_at(&f, 40.0, fs) - edge) + fabs(mag_at(&f, 249.999, fs) - 1.0);
+        snprintf(what, sizeof(what), "high-pass order %d: -3 dB edge, unit Nyquist", order);
+        check_value(e < 1e3 * TOL && sections_stable(f.sections, f.num_sections), what, e);
+    }
+
+    for (int order = 1; order <= IIRDSP_MAX_SECTIONS; order++) {
+        char what[64];
+        butter_bandpass_init(&f, order, 0.5, 40.0, fs);
+        iirdsp_real e = fabs(mag_at(&f, 0.5, fs) - edge) + fabs(mag_at(&f, 40.0, fs) - edge);
+        snprintf(what, sizeof(what), "band-pass order %d: -3 dB at both edges", order);
+        check_value(e < 1e4 * TOL && sections_stable(f.sections, f.num_sections), what, e);
+    }
+
+    /* Uniform grid vs arbitrary-frequency evaluation */
+    printf("\nGrid evaluation (%d points):\n", GRID);
+    static iirdsp_real freqs[GRID], mag[GRID], phase[GRID], gd[GRID];
+    static iirdsp_real mag2[GRID], phase2[GRID], gd2[GRID];
+
+    butter_bandpass_init(&f, 4, 0.5, 40.0, fs);
+    iirdsp_sosfreqz_grid(&f, GRID, fs, freqs, mag, phase, gd);
+    iirdsp_sosfreqz(&f, freqs, GRID, fs, mag2, phase2, gd2);
+
+    iirdsp_real err = 0.0;
+    for (int k = 0; k < GRID; k++) {
+        err = fmax(err, fabs(mag[k] - mag2[k]));
+        err = fmax(err, fabs(gd[k] - gd2[k]) / (1.0 + fabs(gd2[k])));
+    }
+    check_value(err < 1e4 * TOL, "grid matches arbitrary-frequency path", err);
+
+    /* Group delay vs -d(phase)/dw by central difference */
+    err = 0.0;
+    const iirdsp_real h = (TOL < 1e-6) ? 1e-4 : 1e-2;
+    for (int k = 1; k < GRID; k += 37) {
+        iirdsp_real fk[2] = { freqs[k] - h, freqs[k] + h };
+        iirdsp_real ph[2];
+        iirdsp_sosfreqz(&f, fk, 2, fs, NULL, ph, NULL);
+        iirdsp_real dphi = remainder(ph[1] - ph[0], 2.0 * M_PI);
+        iirdsp_real numeric = -dphi / (2.0 * M_PI * 2.0 * h / fs);
+        err = fmax(err, fabs(numeric - gd[k]) / (1.0 + fabs(gd[k])));
+    }
+    check_value(err < GD_TOL, "group delay matches phase derivative", err);
+
+    /* Per-section delays must add up to the cascade delay */
+    printf("\nGroup delay metrics:\n");
+    static iirdsp_real sec_gd[GRID];
+    err = 0.0;
+    for (int k = 0; k < GRID; k++) {
+        gd2[k] = 0.0;
+    }
+    for (int i = 0; i < f.num_sections; i++) {
+        iirdsp_section_group_delay(&f.sections[i], freqs, GRID, fs, sec_gd);
+        for (int k = 0; k < GRID; k++) {
+            gd2[k] += sec_gd[k];
+        }
+    }
+    for (int k = 0; k < GRID; k++) {
+        err = fmax(err, fabs(gd2[k] - gd[k]) / (1.0 + fabs(gd[k])));
+    }
+    check_value(err < 1e4 * TOL, "section delays sum to total", err);
+
+    /* Passband summary agrees with a direct scan of the grid */
+    iirdsp_delay_summary_t summary;
+    iirdsp_passband_delay(&f, 0.5, 40.0, fs, 1000, &summary);
+    iirdsp_real scan_max = 0.0;
+    for (int k = 0; k < GRID; k++) {
+        if (freqs[k] >= 0.5 && freqs[k] <= 40.0) {
+            scan_max = fmax(scan_max, gd[k]);
+        }
+    }
+    printf("  band-pass 0.5-40 Hz: max %.1f @ %.2f Hz, min %.1f, mean %.1f samples\n",
+           summary.max_delay, summary.max_delay_hz, summary.min_delay, summary.mean_delay);
+    iirdsp_real at_max;
+    iirdsp_group_delay(&f, &summary.max_delay_hz, 1, fs, &at_max);
+    check_value(summary.max_delay >= scan_max * (1.0 - 1e-6) && fabs(at_max - summary.max_delay) < 1e-6 * at_max,
+          "worst-case passband delay", summary.max_delay);
+    check_value(summary.min_delay <= summary.mean_delay && summary.mean_delay <= summary.max_delay
+          && fabs(summary.delay_spread - (summary.max_delay - summary.min_delay)) < 1e-9,
+          "summary is consistent", summary.delay_spread);
+
+    /* A 2-sample delay line has exactly 2 samples of delay everywhere */
+    iirdsp_biquad_t delay2 = { 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0 };
+    iirdsp_section_group_delay(&delay2, freqs, 16, fs, sec_gd);
+    err = 0.0;
+    for (int k = 0; k < 16; k++) {
+        err = fmax(err, fabs(sec_gd[k] - 2.0));
+    }
+    check_value(err < TOL, "pure delay section", err);
+
+    /* Impulse-response length estimate vs simulated decay */
+    printf("\nImpulse-response length (eps = 1e-4):\n");
+    {
+        iirdsp_filter_t cases[4];
+        const char* names[4] = { "low-pass 4, 10 Hz", "high-pass 2, 0.5 Hz",
+                                 "band-pass 4, 0.5-40 Hz", "notch 50 Hz, Q=30" };
+        butter_lowpass_init(&cases[0], 4, 10.0, fs);
+        butter_highpass_init(&cases[1], 2, 0.5, fs);
+        butter_bandpass_init(&cases[2], 4, 0.5, 40.0, fs);
+        notch_filter_init(&cases[3], 50.0, 30.0, fs);
+
+        for (int i = 0; i < 4; i++) {
+            char what[64];
+            int est = iirdsp_impulse_length(&cases[i], 1e-4);
+            int sim = simulated_length(&cases[i], 1e-4);
+            snprintf(what, sizeof(what), "%s: %d est vs %d", names[i], est, sim);
+            check_value(est >= sim && est <= 1.2 * sim + 10, what, (double)est / sim);
+        }
+
+        iirdsp_biquad_t unstable = { 1.0, 0.0, 0.0, -2.0, 1.0, 0.0, 0.0 };
+        cases[0].sections[0] = unstable;
+        cases[0].num_sections = 1;
+        check_value(iirdsp_impulse_length(&cases[0], 1e-4) == -1, "pole on unit circle rejected", 0.0);
+
+        check_value(iirdsp_impulse_length(&cases[3], -1e-6) == -2 &&
+              iirdsp_impulse_length(&cases[3], 0.0) == -2 &&
+              iirdsp_impulse_length(&cases[3], NAN) == -2, "non-positive eps rejected", 0.0);
+
+#ifndef IIRDSP_USE_FLOAT
+        /* Radius 1 - 1e-10: about 1.4e11 samples to reach 1e-6 */
+        double r = 1.0 - 1e-10;
+        iirdsp_biquad_t slow = { 1.0, 0.0, 0.0, -2.0 * r * cos(0.1), r * r, 0.0, 0.0 };
+        cases[0].sections[0] = slow;
+        check_value(iirdsp_impulse_length(&cases[0], 1e-6) == -3, "length beyond INT_MAX rejected", 0.0);
+#endif
+    }
+
+    return test_summary();
+}
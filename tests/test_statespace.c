@@ -0,0 +1,95 @@
+/**
+ * @file test_statespace.c
+ * @brief Block state-space engine accuracy and state hand-over against DF2T
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL 1e-3
+#else
+#define TOL 1e-10
+#endif
+
+static iirdsp_statespace_t ss;  /* Large; keep it off the stack */
+
+int main(void)
+{
+    iirdsp_filter_t filters[6];
+    const char* names[6] = { "low-pass 4, 40 Hz", "high-pass 2, 0.5 Hz", "band-pass 4, 0.5-40 Hz",
+                             "low-pass 3, 10 Hz", "notch 50 Hz", "band-pass 8, 5-15 Hz" };
+    const int block_lengths[4] = { 0, 16, 24, IIRDSP_STATESPACE_MAX_BLOCK };
+    const iirdsp_real fs = 500.0;
+    int failures = 0;
+
+    printf("iirdsp Block State-Space Test\n");
+    printf("=============================\n\n");
+
+    butter_lowpass_init(&filters[0], 4, 40.0, fs);
+    butter_highpass_init(&filters[1], 2, 0.5, fs);
+    butter_bandpass_init(&filters[2], 4, 0.5, 40.0, fs);
+    butter_lowpass_init(&filters[3], 3, 10.0, fs);
+    notch_filter_init(&filters[4], 50.0, 30.0, fs);
+    butter_bandpass_init(&filters[5], 8, 5.0, 15.0, fs);  /* 16 states */
+
+    for (int i = 0; i < 6; i++) {
+        for (int b = 0; b < 4; b++) {
+            int rc = iirdsp_statespace_init(&ss, &filters[i], block_lengths[b]);
+            /* Odd length exercises the per-sample tail */
+            iirdsp_real err = iirdsp_statespace_max_error(&ss, &filters[i], 5001);
+            int ok = (rc == 0) && err < TOL;
+
+            printf("  %-24s L=%-2d max error %-12g %s\n", names[i], ss.L, err, ok ? "ok" : "FAIL");
+            if (!ok) {
+                failures++;
+            }
+        }
+    }
+
+    /* Hand state over DF2T -> state-space -> DF2T mid-stream */
+    {
+        static iirdsp_real x[3000], y_ref[3000], y[3000];
+        iirdsp_filter_t ref = filters[2];
+        iirdsp_filter_t f = filters[2];
+
+        for (int n = 0; n < 3000; n++) {
+            x[n] = sin(0.01 * n * n);
+        }
+        iirdsp_filter_init(&ref);
+        iirdsp_process_buffer(&ref, x, y_ref, 3000);
+
+        iirdsp_filter_init(&f);
+        iirdsp_statespace_init(&ss, &f, 0);
+        iirdsp_process_buffer(&f, x, y, 1000);
+        iirdsp_statespace_load_state(&ss, &f);
+        iirdsp_statespace_process_buffer(&ss, x + 1000, y + 1000, 1000);
+        iirdsp_statespace_store_state(&ss, &f);
+        iirdsp_process_buffer(&f, x + 2000, y + 2000, 1000);
+
+        iirdsp_real err = 0.0;
+        for (int n = 0; n < 3000; n++) {
+            err = fmax(err, fabs(y[n] - y_ref[n]));
+        }
+        int ok = err < TOL;
+        printf("  %-32s max error %-12g %s\n", "state hand-over", err, ok ? "ok" : "FAIL");
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    if (iirdsp_statespace_init(&ss, &filters[0], 7) != -1 ||
+        iirdsp_statespace_init(&ss, &filters[0], IIRDSP_STATESPACE_MAX_BLOCK + 8) != -1) {
+        printf("  invalid block length not rejected FAIL\n");
+        failures++;
+    }
+
+    if (failures == 0) {
+        printf("\n✓ Test PASSED\n");
+        return 0;
+    } else {
+        printf("\n✗ Test FAILED (%d failures)\n", failures);
+        return -1;
+    }
+}
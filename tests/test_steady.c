@@ -0,0 +1,72 @@
+/**
+ * @file test_steady.c
+ * @brief Steady-state warm start must remove the start-up transient
+ *
+ * After iirdsp_filter_init_steady(f, x0), a constant input x0 must produce
+ * the settled output (x0 * DC gain) from the very first sample.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+
+#ifdef IIRDSP_USE_FLOAT
+#define TOL 1e-4
+#else
+#define TOL 1e-9
+#endif
+
+static int failures = 0;
+
+static void check_constant(iirdsp_filter_t* f, const char* name, iirdsp_real x0, iirdsp_real dc_gain)
+{
+    iirdsp_real err = 0.0;
+
+    iirdsp_filter_init_steady(f, x0);
+    for (int n = 0; n < 2000; n++) {
+        err = fmax(err, fabs(iirdsp_process_sample(f, x0) - dc_gain * x0));
+    }
+
+    printf("  %-28s max deviation %g %s\n", name, err, err < TOL ? "ok" : "FAIL");
+    if (err >= TOL) {
+        failures++;
+    }
+}
+
+int main(void)
+{
+    iirdsp_filter_t f;
+    const iirdsp_real fs = 500.0;
+
+    printf("iirdsp Steady-State Init Test\n");
+    printf("=============================\n\n");
+
+    butter_highpass_init(&f, 2, 0.5, fs);
+    check_constant(&f, "high-pass 0.5 Hz, order 2", 1.7, 0.0);
+
+    butter_lowpass_init(&f, 5, 0.5, fs);
+    check_constant(&f, "low-pass 0.5 Hz, order 5", -3.2, 1.0);
+
+    butter_bandpass_init(&f, 4, 0.5, 40.0, fs);
+    check_constant(&f, "band-pass 0.5-40 Hz, order 4", 2.5, 0.0);
+
+    notch_filter_init(&f, 50.0, 30.0, fs);
+    check_constant(&f, "notch 50 Hz", 0.8, 1.0);
+
+    /* A pole at DC has no steady state */
+    iirdsp_biquad_t integrator = { 1.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0 };
+    f.sections[0] = integrator;
+    f.num_sections = 1;
+    int rc = iirdsp_filter_init_steady(&f, 1.0);
+    printf("  %-28s rc=%d %s\n", "integrator rejected", rc, rc == -1 ? "ok" : "FAIL");
+    if (rc != -1) {
+        failures++;
+    }
+
+    if (failures == 0) {
+        printf("\n✓ Test PASSED\n");
+        return 0;
+    }
+    printf("\n✗ Test FAILED (%d failures)\n", failures);
+    return -1;
+}
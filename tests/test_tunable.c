@@ -0,0 +1,156 @@
+/**
+ * @file test_tunable.c
+ * @brief Tunable-cutoff filter against exact Butterworth designs
+ *
+ * On table points the interpolated filter must equal the exact design;
+ * between them the magnitude response must stay close to it. Retuning
+ * must keep the state, and a large ramped retune must not produce a
+ * step in the output.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+#include "test_util.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/*
+ * Largest |H| deviation allowed on and halfway between table points. In
+ * float, a direct design at a 0.05 Hz cutoff is itself a few percent off
+ * near the cutoff (poles within 1e-3 of z = 1), so the reference is the
+ * looser bound there.
+ */
+#ifdef IIRDSP_USE_FLOAT
+#define TOL_EXACT 1e-3
+#define TOL_INTERP 5e-2
+#else
+#define TOL_EXACT 1e-9
+#define TOL_INTERP 1e-2
+#endif
+
+#define NUM_FREQS 200
+
+/* Max |H| difference over fc/20 .. 20*fc (capped below Nyquist) */
+static iirdsp_real response_error(
+    const iirdsp_filter_t* a,
+    const iirdsp_filter_t* b,
+    iirdsp_real fc,
+    iirdsp_real fs
+)
+{
+    iirdsp_real freqs[NUM_FREQS], mag_a[NUM_FREQS], mag_b[NUM_FREQS];
+    iirdsp_real f_hi = fmin(20.0 * fc, 0.49 * fs);
+    iirdsp_real err = 0.0;
+
+    for (int i = 0; i < NUM_FREQS; i++) {
+        freqs[i] = fc / 20.0 * pow(f_hi / (fc / 20.0), (iirdsp_real)i / (NUM_FREQS - 1));
+    }
+    iirdsp_sosfreqz(a, freqs, NUM_FREQS, fs, mag_a, NULL, NULL);
+    iirdsp_sosfreqz(b, freqs, NUM_FREQS, fs, mag_b, NULL, NULL);
+    for (int i = 0; i < NUM_FREQS; i++) {
+        err = fmax(err, fabs(mag_a[i] - mag_b[i]));
+    }
+    return err;
+}
+
+static void check_range(
+    iirdsp_btype_t type,
+    int order,
+    iirdsp_real f_min,
+    iirdsp_real f_max,
+    iirdsp_real fs,
+    int num_points
+)
+{
+    static iirdsp_tunable_t t;
+    iirdsp_filter_t exact;
+    iirdsp_real err_points = 0.0, err_mid = 0.0;
+    char name[80];
+
+    iirdsp_tunable_init(&t, type, order, f_min, f_max, fs, num_points);
+
+    for (int p = 0; p < num_points - 1; p++) {
+        for (int half = 0; half < 2; half++) {
+            iirdsp_real fc = f_min * pow(f_max / f_min, (p + 0.5 * half) / (num_points - 1));
+            if (type == IIRDSP_LOWPASS) {
+                butter_lowpass_init(&exact, order, fc, fs);
+            } else {
+                butter_highpass_init(&exact, order, fc, fs);
+            }
+            iirdsp_tunable_set_cutoff(&t, fc);
+            iirdsp_real err = response_error(&t.filter, &exact, fc, fs);
+            if (half) {
+                err_mid = fmax(err_mid, err);
+            } else {
+                err_points = fmax(err_points, err);
+            }
+        }
+    }
+
+    snprintf(name, sizeof(name), "%s order %d, %g-%g Hz, table points",
+             type == IIRDSP_LOWPASS ? "LP" : "HP", order, f_min, f_max);
+    printf("    max |H| error %g\n", err_points);
+    check(name, err_points < TOL_EXACT);
+    snprintf(name, sizeof(name), "%s order %d, %g-%g Hz, midpoints",
+             type == IIRDSP_LOWPASS ? "LP" : "HP", order, f_min, f_max);
+    printf("    max |H| error %g\n", err_mid);
+    check(name, err_mid < TOL_INTERP);
+}
+
+int main(void)
+{
+    static iirdsp_tunable_t t;
+    const iirdsp_real fs = 500.0;
+
+    printf("iirdsp Tunable Cutoff Test\n");
+    printf("==========================\n\n");
+
+    check_range(IIRDSP_HIGHPASS, 2, 0.05, 5.0, fs, 32);
+    check_range(IIRDSP_HIGHPASS, 5, 0.1, 2.0, fs, 16);
+    check_range(IIRDSP_LOWPASS, 4, 5.0, 150.0, fs, 32);
+    check_range(IIRDSP_LOWPASS, 3, 20.0, 40.0, fs, 6);
+
+    /* Retuning keeps state */
+    iirdsp_tunable_init(&t, IIRDSP_HIGHPASS, 2, 0.05, 5.0, fs, 32);
+    for (int n = 0; n < 100; n++) {
+        iirdsp_process_sample(&t.filter, 1.0);
+    }
+    iirdsp_real z1 = t.filter.sections[0].z1;
+    iirdsp_tunable_set_cutoff(&t, 1.0);
+    check("set_cutoff keeps z1/z2", t.filter.sections[0].z1 == z1 && z1 != 0.0);
+    check("get_cutoff round trip", fabs(iirdsp_tunable_get_cutoff(&t) - 1.0) < 1e-3);
+    iirdsp_tunable_set_cutoff(&t, 100.0);
+    check("cutoff clamped to range", fabs(iirdsp_tunable_get_cutoff(&t) - 5.0) < 1e-3);
+
+    /* 10 Hz tone settled at the lowest cutoff, then a ramp over the whole
+     * range: the passband tone must come through without a step */
+    {
+        static iirdsp_real x[4000], y[4000];
+        iirdsp_real peak = 0.0;
+
+        iirdsp_tunable_init(&t, IIRDSP_HIGHPASS, 2, 0.05, 5.0, fs, 32);
+        for (int n = 0; n < 4000; n++) {
+            x[n] = sin(2.0 * M_PI * 10.0 * n / fs);
+        }
+        iirdsp_tunable_process_ramp(&t, x, y, 3000, 0.05);
+        iirdsp_tunable_process_ramp(&t, x + 3000, y + 3000, 1000, 5.0);
+        for (int n = 3000; n < 4000; n++) {
+            peak = fmax(peak, fabs(y[n]));
+        }
+        printf("    peak output during ramp %g\n", peak);
+        check("ramped retune without output step", peak < 1.05);
+        check("ramp ends at target", fabs(iirdsp_tunable_get_cutoff(&t) - 5.0) < 1e-3);
+    }
+
+    check("invalid arguments rejected",
+          iirdsp_tunable_init(&t, IIRDSP_BANDPASS, 2, 1.0, 5.0, fs, 8) == -3 &&
+          iirdsp_tunable_init(&t, IIRDSP_LOWPASS, 2, 1.0, 5.0, fs, 1) == -3 &&
+          iirdsp_tunable_init(&t, IIRDSP_LOWPASS, 2, 5.0, 1.0, fs, 8) == -2 &&
+          iirdsp_tunable_init(&t, IIRDSP_LOWPASS, 2, 1.0, 300.0, fs, 8) == -2 &&
+          iirdsp_tunable_init(&t, IIRDSP_LOWPASS, 0, 1.0, 5.0, fs, 8) == -1);
+
+    return test_summary();
+}
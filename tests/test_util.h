@@ -0,0 +1,60 @@
+/**
+ * @file test_util.h
+ * @brief Helpers shared by the test programs
+ *
+ * Each test is a single translation unit, so the failure count and the
+ * helpers are static. Include after iirdsp.h.
+ */
+
+#ifndef IIRDSP_TEST_UTIL_H
+#define IIRDSP_TEST_UTIL_H
+
+#include <stdio.h>
+#include <math.h>
+#include "iirdsp.h"
+
+static int failures = 0;
+
+/* Print one named result and count it if it failed */
+static inline void check(const char* name, int ok)
+{
+    printf("  %-44s %s\n", name, ok ? "ok" : "FAIL");
+    if (!ok) {
+        failures++;
+    }
+}
+
+/* Print the verdict; returns the exit status for main */
+static inline int test_summary(void)
+{
+    if (failures == 0) {
+        printf("\n✓ Test PASSED\n");
+        return 0;
+    } else {
+        printf("\n✗ Test FAILED (%d failures)\n", failures);
+        return -1;
+    }
+}
+
+/* Loss in dB (positive) of f at freq_hz */
+static inline iirdsp_real loss_db(const iirdsp_filter_t* f, iirdsp_real freq_hz, iirdsp_real fs_hz)
+{
+    iirdsp_real mag;
+    iirdsp_sosfreqz(f, &freq_hz, 1, fs_hz, &mag, NULL, NULL);
+    return -20.0 * log10(mag);
+}
+
+/* Both poles of every section strictly inside the unit circle */
+static inline int sections_stable(const iirdsp_biquad_t* sections, int num_sections)
+{
+    for (int i = 0; i < num_sections; i++) {
+        const iirdsp_real a1 = sections[i].a1;
+        const iirdsp_real a2 = sections[i].a2;
+        if (!(fabs(a2) < 1.0 && fabs(a1) < 1.0 + a2)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif /* IIRDSP_TEST_UTIL_H */